@@ -0,0 +1,314 @@
+/*!*****************************************************************
+ * \file    at_parser_bench.c
+ * \brief   AT parser host benchmark.
+ *******************************************************************
+ * \copyright
+ *
+ * Copyright (c) 2024, UnaBiz SAS
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  1 Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  2 Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *  3 Neither the name of UnaBiz SAS nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *******************************************************************/
+
+#include "at.h"
+
+#include "at_hw_api.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+
+/*** BENCH local macros ***/
+
+#define BENCH_DEFAULT_ITERATIONS            100000
+#define BENCH_SYNTAX_SIZE                   8
+#define BENCH_LINE_SIZE                     32
+#define BENCH_MIXED_LINES_NUMBER            9
+
+/*** BENCH local structures ***/
+
+/*******************************************************************/
+typedef enum {
+    BENCH_KIND_EXECUTION = 0,
+    BENCH_KIND_READ,
+    BENCH_KIND_WRITE,
+    BENCH_KIND_LAST
+} BENCH_kind_t;
+
+/*******************************************************************/
+typedef struct {
+    // Hardware interface callbacks.
+    AT_HW_API_ex_config_t hw_config;
+    // Memory sink statistics.
+    uint64_t bytes_written;
+    uint64_t write_calls;
+} BENCH_sink_t;
+
+/*******************************************************************/
+typedef struct {
+    uint64_t lines;
+    uint64_t elapsed_ns;
+    uint64_t bytes_written;
+    uint64_t write_calls;
+} BENCH_result_t;
+
+/*** BENCH local functions declaration ***/
+
+static AT_status_t _sink_init(void *hw_context, AT_HW_API_ex_config_t *hw_api_config);
+static AT_status_t _sink_de_init(void *hw_context);
+static AT_status_t _sink_write(void *hw_context, uint8_t *data, uint32_t data_size_bytes);
+#ifdef AT_ASYNCHRONOUS_TX
+static AT_status_t _sink_write_async(void *hw_context, uint8_t *data, uint32_t data_size_bytes);
+#endif
+
+#ifdef AT_HELP_COMPRESSED
+/*** BENCH global variables ***/
+
+// The help texts of the benchmark are not compressed.
+const char *const AT_HELP_DICTIONARY[1] = {""};
+const uint8_t AT_HELP_DICTIONARY_SIZE = 0;
+#endif
+
+/*** BENCH local global variables ***/
+
+static const uint32_t BENCH_COMMANDS_NUMBER[] = {1, 16, 64};
+
+static const char *const BENCH_TYPE_NAME[AT_COMMAND_TYPE_LAST] = {"basic", "extended", "debug"};
+static const char *const BENCH_TYPE_HEADER[AT_COMMAND_TYPE_LAST] = {"AT", "AT$", "AT!"};
+static const char *const BENCH_KIND_NAME[BENCH_KIND_LAST] = {"execution", "read", "write"};
+static const char *const BENCH_KIND_SUFFIX[BENCH_KIND_LAST] = {"", "?", "=1,2"};
+
+static const AT_HW_API_ops_t BENCH_SINK_OPS = {
+    .init = &_sink_init,
+    .de_init = &_sink_de_init,
+    .write = &_sink_write,
+#ifdef AT_ASYNCHRONOUS_TX
+    .write_async = &_sink_write_async,
+#endif
+};
+
+static BENCH_sink_t bench_sink;
+static AT_handle_t bench_handle;
+static AT_command_t bench_commands[AT_COMMAND_LIST_SIZE];
+static char bench_syntax[AT_COMMAND_LIST_SIZE][BENCH_SYNTAX_SIZE];
+
+/*** BENCH local functions ***/
+
+/*******************************************************************/
+static AT_status_t _sink_init(void *hw_context, AT_HW_API_ex_config_t *hw_api_config) {
+    // Store callbacks.
+    ((BENCH_sink_t *) hw_context)->hw_config = (*hw_api_config);
+    return AT_SUCCESS;
+}
+
+/*******************************************************************/
+static AT_status_t _sink_de_init(void *hw_context) {
+    (void) hw_context;
+    return AT_SUCCESS;
+}
+
+/*******************************************************************/
+static AT_status_t _sink_write(void *hw_context, uint8_t *data, uint32_t data_size_bytes) {
+    // Local variables.
+    BENCH_sink_t *sink = (BENCH_sink_t *) hw_context;
+    // Data is discarded, only the traffic is counted.
+    (void) data;
+    sink->bytes_written += data_size_bytes;
+    sink->write_calls++;
+    return AT_SUCCESS;
+}
+
+#ifdef AT_ASYNCHRONOUS_TX
+/*******************************************************************/
+static AT_status_t _sink_write_async(void *hw_context, uint8_t *data, uint32_t data_size_bytes) {
+    // Local variables.
+    BENCH_sink_t *sink = (BENCH_sink_t *) hw_context;
+    // Transfer completes immediately.
+    _sink_write(hw_context, data, data_size_bytes);
+    sink->hw_config.tx_done_callback(sink->hw_config.handle);
+    return AT_SUCCESS;
+}
+#endif
+
+/*******************************************************************/
+static void _process_callback(void) {
+    // Lines are processed synchronously by the benchmark loop.
+}
+
+/*******************************************************************/
+static AT_status_t _execution_callback(int32_t *error_code) {
+    (void) error_code;
+    return AT_SUCCESS;
+}
+
+/*******************************************************************/
+static AT_status_t _read_callback(int32_t *error_code) {
+    (void) error_code;
+    return AT_send_reply(NULL, "1");
+}
+
+/*******************************************************************/
+static AT_status_t _write_callback(uint32_t argc, char *argv[], int32_t *error_code) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    (void) argv;
+    // Check parameters number.
+    if (argc != 2) {
+        AT_command_exit_param_number_error(2);
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static uint64_t _get_time_ns(void) {
+    // Local variables.
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t) now.tv_sec * 1000000000ULL) + (uint64_t) now.tv_nsec;
+}
+
+/*******************************************************************/
+static uint32_t _setup(AT_command_type_t type, uint32_t commands_number) {
+    // Local variables.
+    AT_config_t config = {0};
+    uint32_t idx = 0;
+    // Built-in commands are registered as a table, the whole list is available.
+    if (commands_number > AT_COMMAND_LIST_SIZE) {
+        commands_number = AT_COMMAND_LIST_SIZE;
+    }
+    // Init instance.
+    config.process_callback = &_process_callback;
+    if (AT_init_ex(&bench_handle, &config, &BENCH_SINK_OPS, &bench_sink) != AT_SUCCESS) {
+        fprintf(stderr, "AT_init_ex failed\n");
+        exit(1);
+    }
+    // Register commands of the benchmarked type.
+    for (idx = 0; idx < commands_number; idx++) {
+        snprintf(bench_syntax[idx], BENCH_SYNTAX_SIZE, "CMD%02u", (unsigned int) idx);
+        memset(&bench_commands[idx], 0x00, sizeof(AT_command_t));
+        bench_commands[idx].syntax = bench_syntax[idx];
+        bench_commands[idx].type = type;
+        bench_commands[idx].help = "Benchmark command";
+        bench_commands[idx].execution_callback = &_execution_callback;
+        bench_commands[idx].read_callback = &_read_callback;
+        bench_commands[idx].write_callback = &_write_callback;
+        bench_commands[idx].write_arguments = "<a>,<b>";
+        if (AT_register_command_ex(&bench_handle, &bench_commands[idx]) != AT_SUCCESS) {
+            fprintf(stderr, "AT_register_command_ex failed\n");
+            exit(1);
+        }
+    }
+    return commands_number;
+}
+
+/*******************************************************************/
+static void _build_line(char *line, AT_command_type_t type, uint32_t command_idx, BENCH_kind_t kind) {
+    snprintf(line, BENCH_LINE_SIZE, "%sCMD%02u%s\r", BENCH_TYPE_HEADER[type], (unsigned int) command_idx, BENCH_KIND_SUFFIX[kind]);
+}
+
+/*******************************************************************/
+static void _run(char lines[][BENCH_LINE_SIZE], uint32_t lines_number, uint32_t iterations, BENCH_result_t *result) {
+    // Local variables.
+    uint64_t start = 0;
+    uint32_t idx = 0;
+    const char *line = NULL;
+    // Reset sink.
+    bench_sink.bytes_written = 0;
+    bench_sink.write_calls = 0;
+    start = _get_time_ns();
+    for (idx = 0; idx < iterations; idx++) {
+        // Feed the line byte per byte as an UART interrupt would do.
+        for (line = lines[idx % lines_number]; (*line) != '\0'; line++) {
+            bench_sink.hw_config.rx_irq_callback(bench_sink.hw_config.handle, (uint8_t) (*line));
+        }
+        AT_process_ex(&bench_handle);
+    }
+    result->elapsed_ns = _get_time_ns() - start;
+    result->lines = iterations;
+    result->bytes_written = bench_sink.bytes_written;
+    result->write_calls = bench_sink.write_calls;
+}
+
+/*******************************************************************/
+static void _print_result(const char *type_name, const char *kind_name, uint32_t commands_number, BENCH_result_t *result) {
+    // Local variables.
+    double seconds = (double) result->elapsed_ns / 1e9;
+    printf("%-10s %-10s %8u %12.0f %10.1f %12llu %12llu\n",
+        type_name,
+        kind_name,
+        (unsigned int) commands_number,
+        (seconds > 0) ? ((double) result->lines / seconds) : 0.0,
+        (double) result->elapsed_ns / (double) result->lines,
+        (unsigned long long) result->bytes_written,
+        (unsigned long long) result->write_calls);
+}
+
+/*** BENCH functions ***/
+
+/*******************************************************************/
+int main(int argc, char *argv[]) {
+    // Local variables.
+    uint32_t iterations = BENCH_DEFAULT_ITERATIONS;
+    uint32_t config_idx = 0;
+    uint32_t commands_number = 0;
+    uint32_t type = 0;
+    uint32_t kind = 0;
+    char lines[BENCH_MIXED_LINES_NUMBER][BENCH_LINE_SIZE];
+    BENCH_result_t result;
+    // Read iterations number.
+    if (argc > 1) {
+        iterations = (uint32_t) strtoul(argv[1], NULL, 0);
+        if (iterations == 0) {
+            fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+            return 1;
+        }
+    }
+    printf("%u lines per case, AT_BUFFER_SIZE=%u, AT_RX_LINES_NUMBER=%u, AT_TX_BUFFER_SIZE=%u\n\n",
+        (unsigned int) iterations, AT_BUFFER_SIZE, AT_RX_LINES_NUMBER, AT_TX_BUFFER_SIZE);
+    printf("%-10s %-10s %8s %12s %10s %12s %12s\n", "type", "kind", "commands", "lines/s", "ns/line", "bytes", "writes");
+    for (config_idx = 0; config_idx < (sizeof(BENCH_COMMANDS_NUMBER) / sizeof(BENCH_COMMANDS_NUMBER[0])); config_idx++) {
+        for (type = 0; type < AT_COMMAND_TYPE_LAST; type++) {
+            commands_number = _setup((AT_command_type_t) type, BENCH_COMMANDS_NUMBER[config_idx]);
+            // Each kind on the command in the middle of the index.
+            for (kind = 0; kind < BENCH_KIND_LAST; kind++) {
+                _build_line(lines[0], (AT_command_type_t) type, (commands_number / 2), (BENCH_kind_t) kind);
+                _run(lines, 1, iterations, &result);
+                _print_result(BENCH_TYPE_NAME[type], BENCH_KIND_NAME[kind], commands_number, &result);
+            }
+            // Mixed stream on all registered commands.
+            for (kind = 0; kind < BENCH_MIXED_LINES_NUMBER; kind++) {
+                _build_line(lines[kind], (AT_command_type_t) type, ((kind * 7) % commands_number), (BENCH_kind_t) (kind % BENCH_KIND_LAST));
+            }
+            _run(lines, BENCH_MIXED_LINES_NUMBER, iterations, &result);
+            _print_result(BENCH_TYPE_NAME[type], "mixed", commands_number, &result);
+            AT_de_init_ex(&bench_handle);
+        }
+        printf("\n");
+    }
+    return 0;
+}
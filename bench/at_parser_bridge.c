@@ -0,0 +1,335 @@
+/*!*****************************************************************
+ * \file    at_parser_bridge.c
+ * \brief   AT parser TCP, serial port and pseudo terminal bridge.
+ *******************************************************************
+ * \copyright
+ *
+ * Copyright (c) 2024, UnaBiz SAS
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  1 Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  2 Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *  3 Neither the name of UnaBiz SAS nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *******************************************************************/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "at.h"
+
+#include "arpa/inet.h"
+#include "at_hw_posix.h"
+#include "netinet/in.h"
+#include "netinet/tcp.h"
+#include "poll.h"
+#include "signal.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "sys/socket.h"
+#include "unistd.h"
+
+/*** BRIDGE local macros ***/
+
+#define BRIDGE_DEFAULT_TCP_PORT             5555
+#define BRIDGE_DEFAULT_MAX_CLIENTS          1024
+#define BRIDGE_POLL_TIMEOUT_MS              100
+#define BRIDGE_PTY_NAME_SIZE                64
+#define BRIDGE_WRITE_TIMEOUT_MS             1000
+
+/*** BRIDGE local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    AT_handle_t handle;
+    AT_HW_POSIX_port_t port;
+    int slave_fd;
+} BRIDGE_client_t;
+
+/*** BRIDGE local functions declaration ***/
+
+static void _process_callback(void);
+static AT_status_t _ping_execution_callback(int32_t *error_code);
+static AT_status_t _echo_write_callback(uint32_t argc, char *argv[], int32_t *error_code);
+
+#ifdef AT_HELP_COMPRESSED
+/*** BRIDGE global variables ***/
+
+// The help texts of the bridge are not compressed.
+const char *const AT_HELP_DICTIONARY[1] = {""};
+const uint8_t AT_HELP_DICTIONARY_SIZE = 0;
+#endif
+
+/*** BRIDGE local global variables ***/
+
+static const AT_command_t BRIDGE_COMMAND_ECHO = {
+    .syntax = "ECHO",
+    .type = AT_COMMAND_TYPE_EXTENDED,
+    .help = AT_HELP("Bridge echo"),
+    .write_callback = &_echo_write_callback,
+    .write_arguments = AT_HELP("<text>"),
+    .write_help = AT_HELP("Reply the text"),
+};
+
+static const AT_command_t BRIDGE_COMMAND_PING = {
+    .syntax = "PING",
+    .type = AT_COMMAND_TYPE_EXTENDED,
+    .help = AT_HELP("Bridge ping"),
+    .execution_callback = &_ping_execution_callback,
+    .execution_help = AT_HELP("Reply PONG"),
+};
+
+// Sorted by type then by syntax.
+static const AT_command_t *const BRIDGE_COMMANDS[] = {
+    &BRIDGE_COMMAND_ECHO,
+    &BRIDGE_COMMAND_PING,
+};
+
+static AT_HW_POSIX_loop_t bridge_loop;
+static uint32_t bridge_clients_count = 0;
+static uint8_t bridge_lf_flag = 0;
+static uint8_t bridge_verbose_flag = 0;
+
+/*** BRIDGE local functions ***/
+
+/*******************************************************************/
+static void _process_callback(void) {
+    // The loop processes the instances while they have work to do.
+}
+
+/*******************************************************************/
+static AT_status_t _ping_execution_callback(int32_t *error_code) {
+    (*error_code) = 0;
+    return AT_send_reply(&BRIDGE_COMMAND_PING, "PONG");
+}
+
+/*******************************************************************/
+static AT_status_t _echo_write_callback(uint32_t argc, char *argv[], int32_t *error_code) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_command_check_and_exit_param_number_error(1);
+    status = AT_send_reply(&BRIDGE_COMMAND_ECHO, argv[0]);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static void _close_callback(AT_HW_POSIX_port_t *port) {
+    // Local variables.
+    BRIDGE_client_t *client = (BRIDGE_client_t *) port->user_data;
+    AT_de_init_ex(&(client->handle));
+    close(port->fd);
+    if (client->slave_fd >= 0) {
+        close(client->slave_fd);
+    }
+    free(client);
+    bridge_clients_count--;
+    if (bridge_verbose_flag != 0) {
+        fprintf(stderr, "client closed (%u clients)\n", (unsigned int) bridge_clients_count);
+    }
+}
+
+/*******************************************************************/
+static int _add_client(int fd, int slave_fd) {
+    // Local variables.
+    BRIDGE_client_t *client = (BRIDGE_client_t *) malloc(sizeof(BRIDGE_client_t));
+    AT_config_t config = {
+        .default_quiet_flag = 0,
+        .default_verbose_flag = 1,
+        .default_echo_flag = 0,
+        .stop_on_error_flag = 0,
+        .process_callback = &_process_callback,
+        .get_timestamp_callback = NULL,
+        .worker_callback = NULL,
+        .rx_timeout = 0,
+    };
+    if (client == NULL) {
+        return -1;
+    }
+    memset(client, 0, sizeof(BRIDGE_client_t));
+    client->slave_fd = slave_fd;
+    client->port.fd = fd;
+    client->port.write_timeout_ms = BRIDGE_WRITE_TIMEOUT_MS;
+    client->port.skip_lf_flag = bridge_lf_flag;
+    client->port.close_callback = &_close_callback;
+    client->port.user_data = client;
+    if (AT_init_ex(&(client->handle), &config, &AT_HW_POSIX_OPS, &(client->port)) != AT_SUCCESS) {
+        free(client);
+        return -1;
+    }
+    if ((AT_register_table_ex(&(client->handle), BRIDGE_COMMANDS, sizeof(BRIDGE_COMMANDS) / sizeof(BRIDGE_COMMANDS[0])) != AT_SUCCESS) ||
+        (AT_HW_POSIX_loop_add(&bridge_loop, &(client->port)) != AT_SUCCESS)) {
+        AT_de_init_ex(&(client->handle));
+        free(client);
+        return -1;
+    }
+    bridge_clients_count++;
+    return 0;
+}
+
+/*******************************************************************/
+static int _listen(uint16_t tcp_port) {
+    // Local variables.
+    struct sockaddr_in address;
+    int listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int option = 1;
+    if (listen_fd < 0) {
+        return -1;
+    }
+    setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &option, sizeof(option));
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(tcp_port);
+    if ((bind(listen_fd, (struct sockaddr *) &address, sizeof(address)) != 0) || (listen(listen_fd, SOMAXCONN) != 0)) {
+        close(listen_fd);
+        return -1;
+    }
+    return listen_fd;
+}
+
+/*******************************************************************/
+static void _accept(int listen_fd, uint32_t max_clients) {
+    // Local variables.
+    int fd = -1;
+    int option = 1;
+    while (1) {
+        fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            break;
+        }
+        if (bridge_clients_count >= max_clients) {
+            close(fd);
+            continue;
+        }
+        // Replies must not wait for the next ones.
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &option, sizeof(option));
+        if (_add_client(fd, -1) != 0) {
+            close(fd);
+            continue;
+        }
+        if (bridge_verbose_flag != 0) {
+            fprintf(stderr, "client connected (%u clients)\n", (unsigned int) bridge_clients_count);
+        }
+    }
+}
+
+/*******************************************************************/
+static void _usage(const char *name) {
+    fprintf(stderr, "usage: %s [-p tcp port] [-d tty device [-b baud rate]] [-P] [-m max clients] [-l] [-v]\n", name);
+    fprintf(stderr, "    -p: TCP port (default %u), each connection has its own parser instance\n", BRIDGE_DEFAULT_TCP_PORT);
+    fprintf(stderr, "    -d: also bridge a serial port\n");
+    fprintf(stderr, "    -P: also bridge a pseudo terminal (its path is printed)\n");
+    fprintf(stderr, "    -m: maximum number of TCP clients (default %u)\n", BRIDGE_DEFAULT_MAX_CLIENTS);
+    fprintf(stderr, "    -l: accept CR LF terminated lines\n");
+    fprintf(stderr, "    -v: print connections\n");
+}
+
+/*** BRIDGE functions ***/
+
+/*******************************************************************/
+int main(int argc, char *argv[]) {
+    // Local variables.
+    uint16_t tcp_port = BRIDGE_DEFAULT_TCP_PORT;
+    uint32_t max_clients = BRIDGE_DEFAULT_MAX_CLIENTS;
+    const char *tty_path = NULL;
+    uint32_t baud_rate = 0;
+    uint8_t pty_flag = 0;
+    char pty_name[BRIDGE_PTY_NAME_SIZE];
+    struct pollfd poll_fds[2];
+    int listen_fd = -1;
+    int fd = -1;
+    int slave_fd = -1;
+    int option = 0;
+    while ((option = getopt(argc, argv, "p:d:b:Pm:lv")) != -1) {
+        switch (option) {
+        case 'p':
+            tcp_port = (uint16_t) strtoul(optarg, NULL, 0);
+            break;
+        case 'd':
+            tty_path = optarg;
+            break;
+        case 'b':
+            baud_rate = (uint32_t) strtoul(optarg, NULL, 0);
+            break;
+        case 'P':
+            pty_flag = 1;
+            break;
+        case 'm':
+            max_clients = (uint32_t) strtoul(optarg, NULL, 0);
+            break;
+        case 'l':
+            bridge_lf_flag = 1;
+            break;
+        case 'v':
+            bridge_verbose_flag = 1;
+            break;
+        default:
+            _usage(argv[0]);
+            return 1;
+        }
+    }
+    // Closed connections are reported by writev() errors.
+    signal(SIGPIPE, SIG_IGN);
+    if (AT_HW_POSIX_loop_init(&bridge_loop) != AT_SUCCESS) {
+        fprintf(stderr, "event loop initialization failed\n");
+        return 1;
+    }
+    listen_fd = _listen(tcp_port);
+    if (listen_fd < 0) {
+        fprintf(stderr, "cannot listen on TCP port %u\n", (unsigned int) tcp_port);
+        return 1;
+    }
+    if (tty_path != NULL) {
+        if ((AT_HW_POSIX_open_tty(tty_path, baud_rate, &fd) != AT_SUCCESS) || (_add_client(fd, -1) != 0)) {
+            fprintf(stderr, "cannot open %s\n", tty_path);
+            return 1;
+        }
+    }
+    if (pty_flag != 0) {
+        if ((AT_HW_POSIX_open_pty(&fd, &slave_fd, pty_name, sizeof(pty_name)) != AT_SUCCESS) || (_add_client(fd, slave_fd) != 0)) {
+            fprintf(stderr, "cannot create a pseudo terminal\n");
+            return 1;
+        }
+        printf("%s\n", pty_name);
+        fflush(stdout);
+    }
+    // The parser loop is nested with the listening socket.
+    poll_fds[0].fd = listen_fd;
+    poll_fds[0].events = POLLIN;
+    poll_fds[1].fd = AT_HW_POSIX_loop_get_fd(&bridge_loop);
+    poll_fds[1].events = POLLIN;
+    while (1) {
+        if (poll(poll_fds, 2, (AT_HW_POSIX_loop_is_busy(&bridge_loop) != 0) ? 0 : BRIDGE_POLL_TIMEOUT_MS) < 0) {
+            continue;
+        }
+        if ((poll_fds[0].revents & POLLIN) != 0) {
+            _accept(listen_fd, max_clients);
+        }
+        AT_HW_POSIX_loop_run(&bridge_loop, 0);
+    }
+    return 0;
+}
@@ -0,0 +1,774 @@
+/*!*****************************************************************
+ * \file    at_parser_fuzz.c
+ * \brief   AT parser fuzzing target and worst-case timing harness.
+ *******************************************************************
+ * \copyright
+ *
+ * Copyright (c) 2024, UnaBiz SAS
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  1 Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  2 Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *  3 Neither the name of UnaBiz SAS nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *******************************************************************/
+
+
+#include "at.h"
+
+#include "at_hw_api.h"
+#ifdef AT_FUZZ_GENERATED_COMMANDS
+#include "example_commands.h"
+#endif
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+
+/*** FUZZ local macros ***/
+
+#define FUZZ_DEFAULT_ITERATIONS             20000
+#define FUZZ_LINE_SIZE                      ((2 * AT_BUFFER_SIZE) + 16)
+// Bound of the AT_process_ex() calls after each line (help is printed by chunks).
+#define FUZZ_PROCESS_MAX_CALLS              256
+// Timestamp unit is one received byte.
+#define FUZZ_RX_TIMEOUT                     (4 * AT_BUFFER_SIZE)
+#define FUZZ_RANDOM_SEED                    0x2545F491
+
+/*** FUZZ local structures ***/
+
+/*******************************************************************/
+typedef enum {
+    FUZZ_CLASS_VALID = 0,
+    FUZZ_CLASS_LONG,
+    FUZZ_CLASS_ARGUMENTS,
+    FUZZ_CLASS_SCHEMA,
+    FUZZ_CLASS_QUOTES,
+    FUZZ_CLASS_CONCATENATION,
+    FUZZ_CLASS_HEADER,
+    FUZZ_CLASS_BINARY,
+    FUZZ_CLASS_HELP,
+    FUZZ_CLASS_LAST
+} FUZZ_class_t;
+
+/*******************************************************************/
+typedef struct {
+    // Hardware interface callbacks.
+    AT_HW_API_ex_config_t hw_config;
+    // Memory sink statistics.
+    uint64_t bytes_written;
+    uint64_t write_calls;
+#ifdef AT_ASYNCHRONOUS_TX
+    // Transfers are completed by the main loop, once AT_process_ex() returned (deferred mode).
+    uint8_t deferred_flag;
+    uint32_t busy_size;
+#endif
+} FUZZ_sink_t;
+
+/*******************************************************************/
+typedef struct {
+    uint64_t lines;
+    uint64_t bytes_received;
+    uint64_t irq_max_ns;
+    uint64_t process_max_ns;
+    uint64_t process_total_ns;
+    uint32_t process_max_calls;
+} FUZZ_result_t;
+
+/*** FUZZ local functions declaration ***/
+
+static AT_status_t _sink_init(void *hw_context, AT_HW_API_ex_config_t *hw_api_config);
+static AT_status_t _sink_de_init(void *hw_context);
+static AT_status_t _sink_write(void *hw_context, uint8_t *data, uint32_t data_size_bytes);
+#ifdef AT_ASYNCHRONOUS_TX
+static AT_status_t _sink_write_async(void *hw_context, uint8_t *data, uint32_t data_size_bytes);
+static void _sink_complete(FUZZ_sink_t *sink);
+#endif
+static uint8_t _sink_is_busy(void);
+static AT_status_t _execution_callback(int32_t *error_code);
+static AT_status_t _read_callback(int32_t *error_code);
+static AT_status_t _write_callback(uint32_t argc, char *argv[], int32_t *error_code);
+static AT_status_t _typed_write_callback(uint32_t argc, AT_argument_t *argv, int32_t *error_code);
+static AT_status_t _pending_callback(int32_t *error_code);
+static AT_status_t _big_read_callback(int32_t *error_code);
+#ifdef AT_DATA_MODE
+static AT_status_t _data_callback(int32_t *error_code);
+#endif
+
+#if defined(AT_HELP_COMPRESSED) && !defined(AT_FUZZ_GENERATED_COMMANDS)
+/*** FUZZ global variables ***/
+
+// The help texts of the harness are not compressed (the generated commands come with their dictionary).
+const char *const AT_HELP_DICTIONARY[1] = {""};
+const uint8_t AT_HELP_DICTIONARY_SIZE = 0;
+#endif
+
+/*** FUZZ local global variables ***/
+
+static const char *const FUZZ_CLASS_NAME[FUZZ_CLASS_LAST] = {"valid", "long", "arguments", "schema", "quotes", "concat", "header", "binary", "help"};
+
+static const char *const FUZZ_VALID_LINES[] = {
+    "AT", "AT$CMD", "AT$CMD?", "AT$CMD=1,2", "AT$TYP=255,-300,A1B2C3D4,abc,7", "AT$HEX=00FF00FF", "AT!DBG", "AT$PND", "AT$BIG?", "ATE0", "ATV1",
+#ifdef AT_DATA_MODE
+    "AT$DAT",
+#endif
+#ifdef AT_FUZZ_GENERATED_COMMANDS
+    "ATZ", "AT$ID?", "AT!REG=1,2",
+#ifndef AT_WORKER
+    // Worker commands are not executed without worker thread.
+    "AT$SF", "AT$SF=0102,1", "AT$SF=,1",
+#endif
+#endif
+};
+static const char *const FUZZ_SCHEMA_TOKENS[] = {
+    "", "0", "255", "256", "-32769", "0x", "0xFFFFFFFF", "4294967296", "A1B2C3D4", "A1B2C3", "G1B2C3D4", "\"abc\"", "\"a,b", "toolongstring"
+};
+static const char *const FUZZ_CONCATENATION_TOKENS[] = {
+    "$CMD", "$CMD?", "$CMD=1", "$PND", "E0", "$TYP=1,2,00000000,a,3", "$XXX", "", "!DBG", "$BIG?"
+};
+static const char *const FUZZ_HELP_LINES[] = {
+    "AT?", "AT$CMD=?", "AT$TYP=?", "AT$XXX=?", "AT!DBG=?", "AT$=?", "AT=?",
+#ifdef AT_FUZZ_GENERATED_COMMANDS
+    "AT$SF=?", "ATZ=?",
+#endif
+};
+static const char FUZZ_QUOTES_CHARACTERS[] = "\"a,\\; =?";
+
+static const AT_HW_API_ops_t FUZZ_SINK_OPS = {
+    .init = &_sink_init,
+    .de_init = &_sink_de_init,
+    .write = &_sink_write,
+#ifdef AT_ASYNCHRONOUS_TX
+    .write_async = &_sink_write_async,
+#endif
+};
+
+static const AT_command_t FUZZ_COMMANDS[] = {
+    {.syntax = "CMD", .type = AT_COMMAND_TYPE_EXTENDED, .help = "Raw arguments", .execution_callback = &_execution_callback, .execution_help = "Execute",
+        .read_callback = &_read_callback, .read_help = "Read", .write_callback = &_write_callback, .write_arguments = "<a>,...", .write_help = "Write"},
+    {.syntax = "TYP", .type = AT_COMMAND_TYPE_EXTENDED, .help = "Typed arguments", .write_arguments = "<u8>,<i16>,<hex4>,<str8>,<u32>", .write_help = "Write",
+        .write_schema = "u8,i16,hex4,str8,u32", .typed_write_callback = &_typed_write_callback},
+    {.syntax = "HEX", .type = AT_COMMAND_TYPE_EXTENDED, .help = "Hexadecimal echo", .write_arguments = "<hex>", .write_help = "Write",
+        .write_schema = "hex", .typed_write_callback = &_typed_write_callback},
+    {.syntax = "PND", .type = AT_COMMAND_TYPE_EXTENDED, .help = "Pending command", .execution_callback = &_pending_callback, .execution_help = "Execute"},
+    {.syntax = "BIG", .type = AT_COMMAND_TYPE_EXTENDED, .help = "Large reply", .read_callback = &_big_read_callback, .read_help = "Read"},
+    {.syntax = "DBG", .type = AT_COMMAND_TYPE_DEBUG, .help = "Debug command", .execution_callback = &_execution_callback, .execution_help = "Execute"},
+#ifdef AT_DATA_MODE
+    {.syntax = "DAT", .type = AT_COMMAND_TYPE_EXTENDED, .help = "Data frame", .execution_callback = &_data_callback, .execution_help = "Execute"},
+#endif
+};
+
+static FUZZ_sink_t fuzz_sink;
+static AT_handle_t fuzz_handle;
+static volatile uint32_t fuzz_process_requests = 0;
+static uint8_t fuzz_pending_flag = 0;
+static uint32_t fuzz_timestamp = 0;
+static uint32_t fuzz_random = FUZZ_RANDOM_SEED;
+
+/*** FUZZ local functions ***/
+
+/*******************************************************************/
+static AT_status_t _sink_init(void *hw_context, AT_HW_API_ex_config_t *hw_api_config) {
+    // Store callbacks.
+    ((FUZZ_sink_t *) hw_context)->hw_config = (*hw_api_config);
+    return AT_SUCCESS;
+}
+
+/*******************************************************************/
+static AT_status_t _sink_de_init(void *hw_context) {
+    (void) hw_context;
+    return AT_SUCCESS;
+}
+
+/*******************************************************************/
+static AT_status_t _sink_write(void *hw_context, uint8_t *data, uint32_t data_size_bytes) {
+    // Local variables.
+    FUZZ_sink_t *sink = (FUZZ_sink_t *) hw_context;
+    // Data is discarded, only the traffic is counted.
+    (void) data;
+    sink->bytes_written += data_size_bytes;
+    sink->write_calls++;
+    return AT_SUCCESS;
+}
+
+#ifdef AT_ASYNCHRONOUS_TX
+/*******************************************************************/
+static AT_status_t _sink_write_async(void *hw_context, uint8_t *data, uint32_t data_size_bytes) {
+    // Local variables.
+    FUZZ_sink_t *sink = (FUZZ_sink_t *) hw_context;
+    // The parser must not start a transfer before the previous one is done.
+    if (sink->busy_size != 0) {
+        fprintf(stderr, "transfer started while busy\n");
+        exit(1);
+    }
+    _sink_write(hw_context, data, data_size_bytes);
+    if (sink->deferred_flag != 0) {
+        sink->busy_size = data_size_bytes;
+        return AT_SUCCESS;
+    }
+    // Transfer completes immediately.
+    sink->hw_config.tx_done_callback(sink->hw_config.handle);
+    return AT_SUCCESS;
+}
+
+/*******************************************************************/
+static void _sink_complete(FUZZ_sink_t *sink) {
+    // Deferred transfer done (TX complete interrupt).
+    if (sink->busy_size != 0) {
+        sink->busy_size = 0;
+        sink->hw_config.tx_done_callback(sink->hw_config.handle);
+    }
+}
+#endif
+
+/*******************************************************************/
+static uint8_t _sink_is_busy(void) {
+#ifdef AT_ASYNCHRONOUS_TX
+    return (fuzz_sink.busy_size != 0);
+#else
+    return 0;
+#endif
+}
+
+/*******************************************************************/
+static void _process_callback(void) {
+    // Called from the RX interrupt (or by the help printing): the harness loop calls AT_process_ex().
+    fuzz_process_requests++;
+}
+
+/*******************************************************************/
+static uint32_t _get_timestamp(void) {
+    return fuzz_timestamp;
+}
+
+/*******************************************************************/
+static AT_status_t _execution_callback(int32_t *error_code) {
+    (void) error_code;
+    return AT_SUCCESS;
+}
+
+/*******************************************************************/
+static AT_status_t _read_callback(int32_t *error_code) {
+    (void) error_code;
+    return AT_send_reply(NULL, "1");
+}
+
+/*******************************************************************/
+static AT_status_t _write_callback(uint32_t argc, char *argv[], int32_t *error_code) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    uint32_t idx = 0;
+    // Echo every argument to exercise the reply path.
+    for (idx = 0; idx < argc; idx++) {
+        if ((argv[idx] != NULL) && (argv[idx][0] != '\0')) {
+            status = AT_send_reply(NULL, argv[idx]);
+            if (status != AT_SUCCESS) {
+                goto errors;
+            }
+        }
+    }
+    // Odd number of arguments is refused.
+    if ((argc % 2) != 0) {
+        AT_command_exit_param_number_error(argc + 1);
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _typed_write_callback(uint32_t argc, AT_argument_t *argv, int32_t *error_code) {
+    // Local variables.
+    uint32_t idx = 0;
+    (void) error_code;
+    // Send back the first byte array.
+    for (idx = 0; idx < argc; idx++) {
+        if (argv[idx].type == AT_ARGUMENT_TYPE_HEX) {
+            return AT_send_reply_hex(NULL, argv[idx].value.hex.data, argv[idx].value.hex.size);
+        }
+    }
+    return AT_SUCCESS;
+}
+
+/*******************************************************************/
+static AT_status_t _pending_callback(int32_t *error_code) {
+    (void) error_code;
+    // Completed by the harness loop before the next process call.
+    fuzz_pending_flag = 1;
+    return AT_PENDING;
+}
+
+/*******************************************************************/
+static AT_status_t _big_read_callback(int32_t *error_code) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    char *reply = NULL;
+    (void) error_code;
+    // Half of the TX buffer written in place.
+    status = AT_reply_begin(NULL, (AT_TX_BUFFER_SIZE / 2), &reply);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    memset(reply, 'B', (AT_TX_BUFFER_SIZE / 2));
+    status = AT_reply_commit(AT_TX_BUFFER_SIZE / 2);
+errors:
+    return status;
+}
+
+#ifdef AT_DATA_MODE
+/*******************************************************************/
+static void _data_frame_callback(const uint8_t *data, uint32_t size) {
+    (void) data;
+    (void) size;
+}
+
+/*******************************************************************/
+static AT_status_t _data_end_callback(AT_status_t data_status, int32_t *error_code) {
+    (void) error_code;
+    return data_status;
+}
+
+/*******************************************************************/
+static AT_status_t _data_callback(int32_t *error_code) {
+    // Local variables.
+    AT_data_mode_config_t config = {
+        .size = 8,
+        .timeout = FUZZ_RX_TIMEOUT,
+        .data_callback = &_data_frame_callback,
+        .end_callback = &_data_end_callback,
+    };
+    (void) error_code;
+    return AT_enter_data_mode(&config);
+}
+#endif
+
+/*******************************************************************/
+static uint64_t _get_time_ns(void) {
+    // Local variables.
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t) now.tv_sec * 1000000000ULL) + (uint64_t) now.tv_nsec;
+}
+
+/*******************************************************************/
+static uint32_t _get_random(uint32_t max) {
+    // Xorshift generator, so that the generated inputs are reproducible.
+    fuzz_random ^= (fuzz_random << 13);
+    fuzz_random ^= (fuzz_random >> 17);
+    fuzz_random ^= (fuzz_random << 5);
+    return (fuzz_random % max);
+}
+
+/*******************************************************************/
+static void _setup(void) {
+    // Local variables.
+    AT_config_t config = {0};
+    uint32_t idx = 0;
+    // Init instance.
+    config.default_verbose_flag = 1;
+    config.process_callback = &_process_callback;
+    config.get_timestamp_callback = &_get_timestamp;
+    config.rx_timeout = FUZZ_RX_TIMEOUT;
+    fuzz_process_requests = 0;
+    fuzz_pending_flag = 0;
+#ifdef AT_ASYNCHRONOUS_TX
+    fuzz_sink.busy_size = 0;
+#endif
+    if (AT_init_ex(&fuzz_handle, &config, &FUZZ_SINK_OPS, &fuzz_sink) != AT_SUCCESS) {
+        fprintf(stderr, "AT_init_ex failed\n");
+        exit(1);
+    }
+    // Commands which do not fit the configuration (list size, arguments number) are skipped.
+    for (idx = 0; idx < (sizeof(FUZZ_COMMANDS) / sizeof(FUZZ_COMMANDS[0])); idx++) {
+        AT_register_command_ex(&fuzz_handle, &FUZZ_COMMANDS[idx]);
+    }
+#ifdef AT_FUZZ_GENERATED_COMMANDS
+    // Table generated from tools/at_commands_example.json.
+    if (EXAMPLE_register_commands_ex(&fuzz_handle) != AT_SUCCESS) {
+        fprintf(stderr, "EXAMPLE_register_commands_ex failed\n");
+        exit(1);
+    }
+#endif
+}
+
+/*******************************************************************/
+static void _process(FUZZ_result_t *result) {
+    // Local variables.
+    uint64_t start = 0;
+    uint64_t elapsed = 0;
+    uint32_t calls = 0;
+    // Run the main loop until nothing is requested anymore.
+    while (((fuzz_process_requests != 0) || (fuzz_pending_flag != 0) || (_sink_is_busy() != 0)) && (calls < FUZZ_PROCESS_MAX_CALLS)) {
+        if (fuzz_process_requests != 0) {
+            fuzz_process_requests--;
+        }
+        if (fuzz_pending_flag != 0) {
+            fuzz_pending_flag = 0;
+            AT_complete_ex(&fuzz_handle, NULL, AT_SUCCESS, 0);
+        }
+        start = _get_time_ns();
+        AT_process_ex(&fuzz_handle);
+        elapsed = _get_time_ns() - start;
+        calls++;
+        if (result != NULL) {
+            result->process_total_ns += elapsed;
+            if (elapsed > result->process_max_ns) {
+                result->process_max_ns = elapsed;
+            }
+        }
+#ifdef AT_ASYNCHRONOUS_TX
+        // The output is continued by the process callback of the TX done callback.
+        _sink_complete(&fuzz_sink);
+#endif
+    }
+    if ((result != NULL) && (calls > result->process_max_calls)) {
+        result->process_max_calls = calls;
+    }
+}
+
+/*******************************************************************/
+static void _feed(const uint8_t *data, uint32_t size, uint8_t block_flag, FUZZ_result_t *result) {
+    // Local variables.
+    uint64_t start = 0;
+    uint64_t elapsed = 0;
+    uint32_t block_size = 0;
+    while (size > 0) {
+        // Blocks of 1 to 16 bytes, as a DMA or idle line reception would do.
+        block_size = (block_flag != 0) ? ((data[0] & 0x0F) + 1) : 1;
+        if (block_size > size) {
+            block_size = size;
+        }
+        fuzz_timestamp += block_size;
+        start = _get_time_ns();
+        if (block_flag != 0) {
+            fuzz_sink.hw_config.rx_block_callback(fuzz_sink.hw_config.handle, data, block_size);
+        } else {
+            fuzz_sink.hw_config.rx_irq_callback(fuzz_sink.hw_config.handle, data[0]);
+        }
+        elapsed = _get_time_ns() - start;
+        if ((result != NULL) && (elapsed > result->irq_max_ns)) {
+            result->irq_max_ns = elapsed;
+        }
+        data += block_size;
+        size -= block_size;
+        // Main loop reacts to the process callback.
+        _process(result);
+    }
+}
+
+/*******************************************************************/
+static void _append(char *line, uint32_t *size, const char *text) {
+    // Local variables.
+    uint32_t text_size = strlen(text);
+    // Keep room for the end of line.
+    if (((*size) + text_size) >= (FUZZ_LINE_SIZE - 1)) {
+        text_size = (FUZZ_LINE_SIZE - 2) - (*size);
+    }
+    memcpy(&line[*size], text, text_size);
+    (*size) += text_size;
+}
+
+/*******************************************************************/
+static uint32_t _generate(FUZZ_class_t class, char *line) {
+    // Local variables.
+    uint32_t size = 0;
+    uint32_t number = 0;
+    uint32_t idx = 0;
+    char character[2] = {0x00};
+    switch (class) {
+    case FUZZ_CLASS_VALID:
+        _append(line, &size, FUZZ_VALID_LINES[_get_random(sizeof(FUZZ_VALID_LINES) / sizeof(FUZZ_VALID_LINES[0]))]);
+        break;
+    case FUZZ_CLASS_LONG:
+        // Lines from the buffer size to twice the buffer size.
+        _append(line, &size, "AT$CMD=");
+        number = AT_BUFFER_SIZE + _get_random(AT_BUFFER_SIZE);
+        while (size < number) {
+            line[size++] = (char) ('0' + _get_random(10));
+        }
+        break;
+    case FUZZ_CLASS_ARGUMENTS:
+        // Up to twice the maximum number of arguments, some of them empty.
+        _append(line, &size, "AT$CMD=");
+        number = _get_random((2 * AT_COMMAND_PARAMETER_MAX_NUMBER) + 2);
+        for (idx = 0; idx < number; idx++) {
+            if (idx != 0) {
+                _append(line, &size, ",");
+            }
+            while (_get_random(4) != 0) {
+                character[0] = (char) ('0' + _get_random(10));
+                _append(line, &size, character);
+            }
+        }
+        break;
+    case FUZZ_CLASS_SCHEMA:
+        _append(line, &size, "AT$TYP=");
+        number = _get_random(8);
+        for (idx = 0; idx < number; idx++) {
+            if (idx != 0) {
+                _append(line, &size, ",");
+            }
+            _append(line, &size, FUZZ_SCHEMA_TOKENS[_get_random(sizeof(FUZZ_SCHEMA_TOKENS) / sizeof(FUZZ_SCHEMA_TOKENS[0]))]);
+        }
+        break;
+    case FUZZ_CLASS_QUOTES:
+        // Unbalanced quotes and escapes.
+        _append(line, &size, "AT$CMD=");
+        number = _get_random(AT_BUFFER_SIZE / 2);
+        for (idx = 0; idx < number; idx++) {
+            character[0] = FUZZ_QUOTES_CHARACTERS[_get_random(sizeof(FUZZ_QUOTES_CHARACTERS) - 1)];
+            _append(line, &size, character);
+        }
+        break;
+    case FUZZ_CLASS_CONCATENATION:
+        _append(line, &size, "AT");
+        number = 1 + _get_random(AT_BUFFER_SIZE / 4);
+        for (idx = 0; idx < number; idx++) {
+            if (idx != 0) {
+                _append(line, &size, ";");
+            }
+            _append(line, &size, FUZZ_CONCATENATION_TOKENS[_get_random(sizeof(FUZZ_CONCATENATION_TOKENS) / sizeof(FUZZ_CONCATENATION_TOKENS[0]))]);
+        }
+        break;
+    case FUZZ_CLASS_HEADER:
+        // Printable garbage, sometimes after a valid or partial header.
+        number = _get_random(4);
+        _append(line, &size, ((number == 0) ? "AT" : ((number == 1) ? "at" : ((number == 2) ? "A" : ""))));
+        number = _get_random(AT_BUFFER_SIZE);
+        for (idx = 0; idx < number; idx++) {
+            character[0] = (char) (' ' + _get_random(95));
+            _append(line, &size, character);
+        }
+        break;
+    case FUZZ_CLASS_BINARY:
+        // Any byte, including end of line, backspace and null characters.
+        number = 1 + _get_random(AT_BUFFER_SIZE);
+        for (idx = 0; (idx < number) && (size < (FUZZ_LINE_SIZE - 2)); idx++) {
+            line[size++] = (char) _get_random(256);
+        }
+        break;
+    case FUZZ_CLASS_HELP:
+        _append(line, &size, FUZZ_HELP_LINES[_get_random(sizeof(FUZZ_HELP_LINES) / sizeof(FUZZ_HELP_LINES[0]))]);
+        break;
+    default:
+        break;
+    }
+    line[size++] = '\r';
+    return size;
+}
+
+/*******************************************************************/
+static void _check_idle(void) {
+    // Local variables.
+    uint32_t activity = 0;
+    uint32_t wakeup_delay = 0;
+    uint32_t idx = 0;
+    // Let the main loop end the output of the last line.
+    for (idx = 0; idx < FUZZ_PROCESS_MAX_CALLS; idx++) {
+        _process(NULL);
+    }
+    // Nothing can be left once all the transfers are done (a stalled output is never continued).
+    AT_get_activity_ex(&fuzz_handle, &activity, &wakeup_delay);
+    if ((activity & (AT_ACTIVITY_RX_PENDING | AT_ACTIVITY_TX | AT_ACTIVITY_HELP | AT_ACTIVITY_URC | AT_ACTIVITY_PENDING)) != 0) {
+        fprintf(stderr, "parser not idle after the last line (activity 0x%02X)\n", (unsigned int) activity);
+        exit(1);
+    }
+}
+
+/*******************************************************************/
+static void _fuzz_input(const uint8_t *data, size_t size) {
+    // Local variables.
+    static const uint8_t end_of_line = '\r';
+    uint8_t mode = 0;
+    // A fresh instance per input keeps the results reproducible.
+    _setup();
+    // First byte selects the reception mode (and the TX completion mode).
+    if (size > 0) {
+        mode = data[0];
+        data++;
+        size--;
+    }
+#ifdef AT_ASYNCHRONOUS_TX
+    fuzz_sink.deferred_flag = (mode & 0x02);
+#endif
+    _feed(data, (uint32_t) size, (mode & 0x01), NULL);
+    // Terminate the last partial line.
+    _feed(&end_of_line, 1, 0, NULL);
+    _check_idle();
+    AT_de_init_ex(&fuzz_handle);
+}
+
+/*******************************************************************/
+static void _print_result(const char *class_name, FUZZ_result_t *result) {
+    printf("%-10s %8llu %10llu %12llu %14llu %12.1f %10u\n",
+        class_name,
+        (unsigned long long) result->lines,
+        (unsigned long long) result->bytes_received,
+        (unsigned long long) result->irq_max_ns,
+        (unsigned long long) result->process_max_ns,
+        (result->lines != 0) ? ((double) result->process_total_ns / (double) result->lines) : 0.0,
+        (unsigned int) result->process_max_calls);
+}
+
+#ifndef AT_FUZZ_LIBFUZZER
+/*******************************************************************/
+static int _replay(int argc, char *argv[]) {
+    // Local variables.
+    FILE *file = NULL;
+    uint8_t *data = NULL;
+    long size = 0;
+    int idx = 0;
+    // Each file is one fuzzer input (crash reproduction or AFL with @@).
+    for (idx = 0; idx < argc; idx++) {
+        file = fopen(argv[idx], "rb");
+        if (file == NULL) {
+            fprintf(stderr, "cannot open %s\n", argv[idx]);
+            return 1;
+        }
+        fseek(file, 0, SEEK_END);
+        size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        data = (uint8_t *) malloc((size > 0) ? (size_t) size : 1);
+        if ((data == NULL) || (fread(data, 1, (size_t) size, file) != (size_t) size)) {
+            fprintf(stderr, "cannot read %s\n", argv[idx]);
+            fclose(file);
+            free(data);
+            return 1;
+        }
+        fclose(file);
+        fuzz_sink.bytes_written = 0;
+        _fuzz_input(data, (size_t) size);
+        printf("%s: %ld bytes, %llu bytes written\n", argv[idx], size, (unsigned long long) fuzz_sink.bytes_written);
+        free(data);
+    }
+    return 0;
+}
+#endif
+
+/*** FUZZ functions ***/
+
+#ifdef AT_FUZZ_GENERATED_COMMANDS
+/*******************************************************************/
+AT_status_t example_reset(int32_t *error_code) {
+    (void) error_code;
+    return AT_SUCCESS;
+}
+
+/*******************************************************************/
+AT_status_t example_read_id(int32_t *error_code) {
+    (void) error_code;
+    return AT_send_reply(NULL, "0000ABCD");
+}
+
+/*******************************************************************/
+AT_status_t example_send_empty(int32_t *error_code) {
+    (void) error_code;
+    return AT_SUCCESS;
+}
+
+/*******************************************************************/
+AT_status_t example_send(const example_send_arguments_t *arguments, int32_t *error_code) {
+    // Frames larger than 12 bytes or not acknowledged are refused with an error code.
+    if ((arguments->payload_size > 12) || (arguments->ack == 0)) {
+        (*error_code) = 1;
+        return AT_ERROR_EXTERNAL_COMMAND_CORE_ERROR;
+    }
+    if (arguments->payload_size == 0) {
+        return AT_SUCCESS;
+    }
+    return AT_send_reply_hex(NULL, arguments->payload, arguments->payload_size);
+}
+
+/*******************************************************************/
+const char *example_error_to_str(unsigned int error_code) {
+    return (error_code == 1) ? "NACK" : "UNKNOWN";
+}
+
+/*******************************************************************/
+AT_status_t example_write_register(uint32_t argc, char *argv[], int32_t *error_code) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    (void) argv;
+    // <address>,<value>
+    AT_command_check_and_exit_param_number_error(2);
+errors:
+    return status;
+}
+#endif
+
+/*******************************************************************/
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    _fuzz_input(data, size);
+    return 0;
+}
+
+#ifndef AT_FUZZ_LIBFUZZER
+/*******************************************************************/
+int main(int argc, char *argv[]) {
+    // Local variables.
+    uint32_t iterations = FUZZ_DEFAULT_ITERATIONS;
+    uint32_t class = 0;
+    uint32_t idx = 0;
+    uint32_t size = 0;
+    char line[FUZZ_LINE_SIZE];
+    FUZZ_result_t result;
+    int arg = 1;
+    // Replay inputs.
+    if ((argc > 1) && (strcmp(argv[1], "-r") == 0)) {
+        return _replay((argc - 2), &argv[2]);
+    }
+#ifdef AT_ASYNCHRONOUS_TX
+    // Transfers completed by the main loop instead of the write function.
+    if ((argc > arg) && (strcmp(argv[arg], "-d") == 0)) {
+        fuzz_sink.deferred_flag = 1;
+        arg++;
+    }
+#endif
+    // Read iterations number.
+    if (argc > arg) {
+        iterations = (uint32_t) strtoul(argv[arg], NULL, 0);
+        if (iterations == 0) {
+            fprintf(stderr, "usage: %s [-d] [iterations] | -r file...\n", argv[0]);
+            return 1;
+        }
+    }
+    printf("%u lines per input class, AT_BUFFER_SIZE=%u, AT_RX_LINES_NUMBER=%u, AT_TX_BUFFER_SIZE=%u, AT_COMMAND_PARAMETER_MAX_NUMBER=%u\n\n",
+        (unsigned int) iterations, AT_BUFFER_SIZE, AT_RX_LINES_NUMBER, AT_TX_BUFFER_SIZE, AT_COMMAND_PARAMETER_MAX_NUMBER);
+    printf("%-10s %8s %10s %12s %14s %12s %10s\n", "class", "lines", "bytes", "max rx ns", "max process ns", "ns/line", "max calls");
+    for (class = 0; class < FUZZ_CLASS_LAST; class++) {
+        memset(&result, 0x00, sizeof(FUZZ_result_t));
+        _setup();
+        // Lines are received byte per byte, the worst case of the RX interrupt.
+        for (idx = 0; idx < iterations; idx++) {
+            size = _generate((FUZZ_class_t) class, line);
+            _feed((const uint8_t *) line, size, 0, &result);
+            result.bytes_received += size;
+        }
+        result.lines = iterations;
+        _check_idle();
+        _print_result(FUZZ_CLASS_NAME[class], &result);
+        AT_de_init_ex(&fuzz_handle);
+    }
+    return 0;
+}
+#endif
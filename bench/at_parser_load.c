@@ -0,0 +1,333 @@
+/*!*****************************************************************
+ * \file    at_parser_load.c
+ * \brief   AT parser TCP bridge load generator.
+ *******************************************************************
+ * \copyright
+ *
+ * Copyright (c) 2024, UnaBiz SAS
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  1 Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  2 Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *  3 Neither the name of UnaBiz SAS nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *******************************************************************/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "arpa/inet.h"
+#include "errno.h"
+#include "netinet/in.h"
+#include "netinet/tcp.h"
+#include "poll.h"
+#include "stdint.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "sys/socket.h"
+#include "time.h"
+#include "unistd.h"
+
+/*** LOAD local macros ***/
+
+#define LOAD_DEFAULT_HOST                   "127.0.0.1"
+#define LOAD_DEFAULT_TCP_PORT               5555
+#define LOAD_DEFAULT_CONNECTIONS            1
+#define LOAD_DEFAULT_WINDOW                 1
+#define LOAD_DEFAULT_DURATION_S             5
+#define LOAD_DEFAULT_LINE                   "AT$PING"
+#define LOAD_WINDOW_MAX                     256
+#define LOAD_LINE_SIZE_MAX                  128
+#define LOAD_RX_BUFFER_SIZE                 4096
+#define LOAD_TX_BUFFER_SIZE                 (LOAD_WINDOW_MAX * (LOAD_LINE_SIZE_MAX + 1))
+// Latency histogram: bucket N counts latencies lower than 2^N microseconds.
+#define LOAD_HISTOGRAM_SIZE                 32
+#define LOAD_POLL_TIMEOUT_MS                100
+
+/*** LOAD local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    int fd;
+    // Send timestamps of the lines in flight (FIFO).
+    uint64_t sent_ns[LOAD_WINDOW_MAX];
+    uint32_t sent_index;
+    uint32_t in_flight;
+    char rx_buffer[LOAD_RX_BUFFER_SIZE];
+    uint32_t rx_size;
+    char tx_buffer[LOAD_TX_BUFFER_SIZE];
+    uint32_t tx_offset;
+    uint32_t tx_size;
+} LOAD_connection_t;
+
+/*******************************************************************/
+typedef struct {
+    uint64_t lines;
+    uint64_t errors;
+    uint64_t latency_sum_ns;
+    uint64_t latency_max_ns;
+    uint64_t histogram[LOAD_HISTOGRAM_SIZE];
+} LOAD_result_t;
+
+/*** LOAD local global variables ***/
+
+static LOAD_result_t load_result;
+
+/*** LOAD local functions ***/
+
+/*******************************************************************/
+static uint64_t _get_time_ns(void) {
+    // Local variables.
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t) now.tv_sec * 1000000000ULL) + (uint64_t) now.tv_nsec;
+}
+
+/*******************************************************************/
+static int _connect(const char *host, uint16_t tcp_port) {
+    // Local variables.
+    struct sockaddr_in address;
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    int option = 1;
+    if (fd < 0) {
+        return -1;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(tcp_port);
+    if ((inet_pton(AF_INET, host, &address.sin_addr) != 1) || (connect(fd, (struct sockaddr *) &address, sizeof(address)) != 0)) {
+        close(fd);
+        return -1;
+    }
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &option, sizeof(option));
+    return fd;
+}
+
+/*******************************************************************/
+static void _record(LOAD_connection_t *connection, uint64_t now_ns, uint8_t error_flag) {
+    // Local variables.
+    uint64_t latency_ns = 0;
+    uint64_t latency_us = 0;
+    uint32_t bucket = 0;
+    // Status lines are received in the order of the sent lines.
+    latency_ns = now_ns - connection->sent_ns[connection->sent_index];
+    connection->sent_index = (connection->sent_index + 1) % LOAD_WINDOW_MAX;
+    connection->in_flight--;
+    load_result.lines++;
+    load_result.errors += error_flag;
+    load_result.latency_sum_ns += latency_ns;
+    if (latency_ns > load_result.latency_max_ns) {
+        load_result.latency_max_ns = latency_ns;
+    }
+    latency_us = latency_ns / 1000;
+    while ((bucket < (LOAD_HISTOGRAM_SIZE - 1)) && (latency_us >= (1ULL << bucket))) {
+        bucket++;
+    }
+    load_result.histogram[bucket]++;
+}
+
+/*******************************************************************/
+static int _receive(LOAD_connection_t *connection) {
+    // Local variables.
+    ssize_t size = read(connection->fd, &(connection->rx_buffer[connection->rx_size]), LOAD_RX_BUFFER_SIZE - connection->rx_size);
+    uint64_t now_ns = _get_time_ns();
+    char *line = connection->rx_buffer;
+    char *end = NULL;
+    uint32_t remaining = 0;
+    if (size <= 0) {
+        return ((size < 0) && (errno == EINTR)) ? 0 : -1;
+    }
+    connection->rx_size += (uint32_t) size;
+    // Each sent line ends with a status line (OK or ERROR...), the other lines are replies.
+    while ((end = (char *) memchr(line, '\n', connection->rx_size - (uint32_t) (line - connection->rx_buffer))) != NULL) {
+        if ((connection->in_flight > 0) && (strncmp(line, "OK\r", 3) == 0)) {
+            _record(connection, now_ns, 0);
+        } else if ((connection->in_flight > 0) && (strncmp(line, "ERROR", 5) == 0)) {
+            _record(connection, now_ns, 1);
+        }
+        line = end + 1;
+    }
+    remaining = connection->rx_size - (uint32_t) (line - connection->rx_buffer);
+    if (remaining >= LOAD_RX_BUFFER_SIZE) {
+        // Reply longer than the buffer.
+        remaining = 0;
+    }
+    memmove(connection->rx_buffer, line, remaining);
+    connection->rx_size = remaining;
+    return 0;
+}
+
+/*******************************************************************/
+static int _send(LOAD_connection_t *connection, const char *line, uint32_t line_size, uint32_t window) {
+    // Local variables.
+    uint64_t now_ns = _get_time_ns();
+    ssize_t written = 0;
+    // Fill the window, the new lines are written at once.
+    if (connection->tx_offset == connection->tx_size) {
+        connection->tx_offset = 0;
+        connection->tx_size = 0;
+        while (connection->in_flight < window) {
+            memcpy(&(connection->tx_buffer[connection->tx_size]), line, line_size);
+            connection->tx_size += line_size;
+            connection->tx_buffer[connection->tx_size] = '\r';
+            connection->tx_size++;
+            connection->sent_ns[(connection->sent_index + connection->in_flight) % LOAD_WINDOW_MAX] = now_ns;
+            connection->in_flight++;
+        }
+    }
+    if (connection->tx_offset == connection->tx_size) {
+        return 0;
+    }
+    written = send(connection->fd, &(connection->tx_buffer[connection->tx_offset]), connection->tx_size - connection->tx_offset, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (written < 0) {
+        return ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)) ? 0 : -1;
+    }
+    connection->tx_offset += (uint32_t) written;
+    return 0;
+}
+
+/*******************************************************************/
+static uint64_t _get_percentile_us(uint64_t lines, uint32_t percent) {
+    // Local variables.
+    uint64_t count = 0;
+    uint32_t bucket = 0;
+    // Upper bound of the bucket.
+    for (bucket = 0; bucket < LOAD_HISTOGRAM_SIZE; bucket++) {
+        count += load_result.histogram[bucket];
+        if ((count * 100) >= (lines * percent)) {
+            break;
+        }
+    }
+    return (1ULL << bucket);
+}
+
+/*******************************************************************/
+static void _usage(const char *name) {
+    fprintf(stderr, "usage: %s [-h host] [-p tcp port] [-c connections] [-w window] [-t seconds] [-l line]\n", name);
+    fprintf(stderr, "    -w: lines sent without waiting for their status on each connection (at most %u)\n", LOAD_WINDOW_MAX);
+    fprintf(stderr, "    -l: line to send, without end marker (default %s)\n", LOAD_DEFAULT_LINE);
+}
+
+/*** LOAD functions ***/
+
+/*******************************************************************/
+int main(int argc, char *argv[]) {
+    // Local variables.
+    const char *host = LOAD_DEFAULT_HOST;
+    const char *line = LOAD_DEFAULT_LINE;
+    uint16_t tcp_port = LOAD_DEFAULT_TCP_PORT;
+    uint32_t connections_number = LOAD_DEFAULT_CONNECTIONS;
+    uint32_t window = LOAD_DEFAULT_WINDOW;
+    uint32_t duration_s = LOAD_DEFAULT_DURATION_S;
+    uint32_t line_size = 0;
+    LOAD_connection_t *connections = NULL;
+    struct pollfd *poll_fds = NULL;
+    uint64_t start_ns = 0;
+    uint64_t end_ns = 0;
+    double elapsed_s = 0;
+    uint32_t idx = 0;
+    int option = 0;
+    while ((option = getopt(argc, argv, "h:p:c:w:t:l:")) != -1) {
+        switch (option) {
+        case 'h':
+            host = optarg;
+            break;
+        case 'p':
+            tcp_port = (uint16_t) strtoul(optarg, NULL, 0);
+            break;
+        case 'c':
+            connections_number = (uint32_t) strtoul(optarg, NULL, 0);
+            break;
+        case 'w':
+            window = (uint32_t) strtoul(optarg, NULL, 0);
+            break;
+        case 't':
+            duration_s = (uint32_t) strtoul(optarg, NULL, 0);
+            break;
+        case 'l':
+            line = optarg;
+            break;
+        default:
+            _usage(argv[0]);
+            return 1;
+        }
+    }
+    line_size = (uint32_t) strlen(line);
+    if ((connections_number == 0) || (window == 0) || (window > LOAD_WINDOW_MAX) || (duration_s == 0) || (line_size == 0) || (line_size > LOAD_LINE_SIZE_MAX)) {
+        _usage(argv[0]);
+        return 1;
+    }
+    connections = (LOAD_connection_t *) calloc(connections_number, sizeof(LOAD_connection_t));
+    poll_fds = (struct pollfd *) calloc(connections_number, sizeof(struct pollfd));
+    if ((connections == NULL) || (poll_fds == NULL)) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    for (idx = 0; idx < connections_number; idx++) {
+        connections[idx].fd = _connect(host, tcp_port);
+        if (connections[idx].fd < 0) {
+            fprintf(stderr, "cannot connect to %s:%u\n", host, (unsigned int) tcp_port);
+            return 1;
+        }
+        poll_fds[idx].fd = connections[idx].fd;
+    }
+    start_ns = _get_time_ns();
+    end_ns = start_ns + ((uint64_t) duration_s * 1000000000ULL);
+    while (_get_time_ns() < end_ns) {
+        for (idx = 0; idx < connections_number; idx++) {
+            if (_send(&(connections[idx]), line, line_size, window) != 0) {
+                fprintf(stderr, "connection %u closed\n", (unsigned int) idx);
+                return 1;
+            }
+            poll_fds[idx].events = POLLIN | ((connections[idx].tx_offset != connections[idx].tx_size) ? POLLOUT : 0);
+        }
+        if (poll(poll_fds, connections_number, LOAD_POLL_TIMEOUT_MS) <= 0) {
+            continue;
+        }
+        for (idx = 0; idx < connections_number; idx++) {
+            if (((poll_fds[idx].revents & (POLLIN | POLLHUP | POLLERR)) != 0) && (_receive(&(connections[idx])) != 0)) {
+                fprintf(stderr, "connection %u closed\n", (unsigned int) idx);
+                return 1;
+            }
+        }
+    }
+    elapsed_s = (double) (_get_time_ns() - start_ns) / 1e9;
+    printf("%u connections, window %u, line %s\n", (unsigned int) connections_number, (unsigned int) window, line);
+    printf("%llu lines in %.2f s: %.0f lines/s, %llu errors\n",
+        (unsigned long long) load_result.lines, elapsed_s, (double) load_result.lines / elapsed_s, (unsigned long long) load_result.errors);
+    if (load_result.lines > 0) {
+        printf("latency: avg %.1f us, p50 < %llu us, p99 < %llu us, max %.1f us\n",
+            ((double) load_result.latency_sum_ns / (double) load_result.lines) / 1000.0,
+            (unsigned long long) _get_percentile_us(load_result.lines, 50), (unsigned long long) _get_percentile_us(load_result.lines, 99),
+            (double) load_result.latency_max_ns / 1000.0);
+    }
+    for (idx = 0; idx < connections_number; idx++) {
+        close(connections[idx].fd);
+    }
+    free(connections);
+    free(poll_fds);
+    return 0;
+}
@@ -39,8 +39,131 @@
 
 #include "stdint.h"
 
+/*** AT macros ***/
+
+#ifdef AT_CONFIG_FILE
+#include "at_config.h"
+#endif
+
+// Memory profiles (AT_PROFILE_TINY, AT_PROFILE_LARGE or default).
+#if defined(AT_PROFILE_TINY)
+#define AT_PROFILE_BUFFER_SIZE                      64
+#define AT_PROFILE_RX_LINES_NUMBER                  1
+#define AT_PROFILE_TX_BUFFER_SIZE                   32
+#define AT_PROFILE_COMMAND_LIST_SIZE                16
+#define AT_PROFILE_COMMAND_PARAMETER_MAX_NUMBER     4
+#define AT_PROFILE_HELP_LINES_PER_PROCESS           4
+#elif defined(AT_PROFILE_LARGE)
+#define AT_PROFILE_BUFFER_SIZE                      1024
+#define AT_PROFILE_RX_LINES_NUMBER                  4
+#define AT_PROFILE_TX_BUFFER_SIZE                   512
+#define AT_PROFILE_COMMAND_LIST_SIZE                128
+#define AT_PROFILE_COMMAND_PARAMETER_MAX_NUMBER     32
+#define AT_PROFILE_HELP_LINES_PER_PROCESS           32
+#else
+#define AT_PROFILE_BUFFER_SIZE                      128
+#define AT_PROFILE_RX_LINES_NUMBER                  2
+#define AT_PROFILE_TX_BUFFER_SIZE                   128
+#define AT_PROFILE_COMMAND_LIST_SIZE                64
+#define AT_PROFILE_COMMAND_PARAMETER_MAX_NUMBER     10
+#define AT_PROFILE_HELP_LINES_PER_PROCESS           8
+#endif
+
+// Each size can be overridden by the compiler flags or by at_config.h.
+#ifndef AT_BUFFER_SIZE
+#define AT_BUFFER_SIZE                      AT_PROFILE_BUFFER_SIZE
+#endif
+#ifndef AT_RX_LINES_NUMBER
+#define AT_RX_LINES_NUMBER                  AT_PROFILE_RX_LINES_NUMBER
+#endif
+#ifndef AT_TX_BUFFER_SIZE
+#define AT_TX_BUFFER_SIZE                   AT_PROFILE_TX_BUFFER_SIZE
+#endif
+#ifndef AT_COMMAND_LIST_SIZE
+#define AT_COMMAND_LIST_SIZE                AT_PROFILE_COMMAND_LIST_SIZE
+#endif
+#ifndef AT_COMMAND_PARAMETER_MAX_NUMBER
+#define AT_COMMAND_PARAMETER_MAX_NUMBER     AT_PROFILE_COMMAND_PARAMETER_MAX_NUMBER
+#endif
+#ifndef AT_HELP_LINES_PER_PROCESS
+#define AT_HELP_LINES_PER_PROCESS           AT_PROFILE_HELP_LINES_PER_PROCESS
+#endif
+// Constant commands tables, including the built-in commands table.
+#ifndef AT_COMMAND_TABLES_NUMBER
+#define AT_COMMAND_TABLES_NUMBER            2
+#endif
+#if defined(AT_STATISTICS) || defined(AT_METRICS)
+// Statistics and metrics slots of the constant tables commands, given to the tables in registration order.
+#ifndef AT_TABLE_SLOTS_NUMBER
+#define AT_TABLE_SLOTS_NUMBER               AT_COMMAND_LIST_SIZE
+#endif
+#endif
+#ifdef AT_ASYNCHRONOUS_TX
+// Size of the replies of the running command staged while the TX ring is busy.
+#ifndef AT_TX_REPLY_SIZE
+#define AT_TX_REPLY_SIZE                    AT_TX_BUFFER_SIZE
+#endif
+#endif
+#ifdef AT_WORKER
+// Size of the replies buffered for each line executed by a worker.
+#ifndef AT_WORKER_REPLY_SIZE
+#define AT_WORKER_REPLY_SIZE                128
+#endif
+#endif
+
+// Help texts of the commands definitions (removed from the binary with the AT_NO_HELP option).
+#ifdef AT_NO_HELP
+#define AT_HELP(text)                       ((const char *) 0)
+#else
+#define AT_HELP(text)                       (text)
+#endif
+#ifdef AT_HELP_COMPRESSED
+// Help bytes from AT_HELP_TOKEN are replaced by the word (byte - AT_HELP_TOKEN) of AT_HELP_DICTIONARY when printed.
+#define AT_HELP_TOKEN                       0x80
+#endif
+#ifdef AT_URC
+// Unsolicited result codes queue (number of slots and size of each code).
+#ifndef AT_URC_NUMBER
+#define AT_URC_NUMBER                       4
+#endif
+#ifndef AT_URC_SIZE
+#define AT_URC_SIZE                         64
+#endif
+#endif
+#ifdef AT_READ_CACHE
+// Read replies cache (number of entries and size of the replies of each entry).
+#ifndef AT_READ_CACHE_NUMBER
+#define AT_READ_CACHE_NUMBER                4
+#endif
+#ifndef AT_READ_CACHE_SIZE
+#define AT_READ_CACHE_SIZE                  64
+#endif
+#endif
+
 /*** AT structures ***/
 
+/*!******************************************************************
+ * \brief AT index types, sized according to the configuration.
+ * \brief AT_line_size_t:             RX line position or size.
+ * \brief AT_tx_size_t:               TX buffer position or size.
+ * \brief AT_command_index_t:         Command slot or index position.
+ *******************************************************************/
+#if (AT_BUFFER_SIZE <= 0xFF)
+typedef uint8_t AT_line_size_t;
+#else
+typedef uint16_t AT_line_size_t;
+#endif
+#if (AT_TX_BUFFER_SIZE <= 0xFF)
+typedef uint8_t AT_tx_size_t;
+#else
+typedef uint16_t AT_tx_size_t;
+#endif
+#if (AT_COMMAND_LIST_SIZE < 0xFF)
+typedef uint8_t AT_command_index_t;
+#else
+typedef uint16_t AT_command_index_t;
+#endif
+
 /*!******************************************************************
  * \enum AT_status_t
  * \brief AT driver error codes.
@@ -68,6 +191,23 @@ typedef enum {
     AT_ERROR_COMMAND_NOT_REGISTERED,
     AT_ERROR_TX_BUFFER_SIZE,
     AT_ERROR_AT_HW_API,
+    AT_ERROR_COMMAND_SCHEMA,
+    AT_ERROR_DATA_MODE,
+    AT_ERROR_COMMANDS_TABLE,
+    AT_ERROR_COMMANDS_TABLES_FULL,
+    AT_ERROR_COMMAND_NOT_PENDING,
+    AT_ERROR_URC_QUEUE_FULL,
+    AT_ERROR_URC_SIZE,
+    AT_ERROR_WORKER_NO_JOB,
+    AT_ERROR_REPLY_STATE,
+    AT_ERROR_HEX_FORMAT,
+    AT_ERROR_HEX_SIZE,
+    AT_ERROR_TX_BUSY,
+    // Data mode errors (printed on terminal, placed after the driver errors so that their values do not change).
+    AT_ERROR_INTERNAL_DATA_CRC,                      /*! CRC of the received data frame is incorrect. */
+    AT_ERROR_INTERNAL_DATA_TIMEOUT,                  /*! Data frame not complete before the timeout. */
+    // Deferred completion (only returned by user command callbacks, the status is given later by AT_complete()).
+    AT_PENDING,
     // Last index.
     AT_ERROR_LAST
 } AT_status_t;
@@ -83,33 +223,142 @@ typedef enum {
     AT_COMMAND_TYPE_LAST
 } AT_command_type_t;
 
+/*!******************************************************************
+ * \enum AT_command_mode_t
+ * \brief AT command execution modes (AT_WORKER option).
+ *******************************************************************/
+typedef enum {
+    AT_COMMAND_MODE_INLINE = 0, /*! Executed by AT_process(), in order with the other lines. */
+    AT_COMMAND_MODE_WORKER,     /*! Executed by a worker, serialized with the worker commands of the same resource. */
+    AT_COMMAND_MODE_REENTRANT,  /*! Executed by a worker, in parallel with any other command. */
+    AT_COMMAND_MODE_LAST
+} AT_command_mode_t;
+
+/*!******************************************************************
+ * \enum AT_argument_type_t
+ * \brief AT typed argument types.
+ *******************************************************************/
+typedef enum {
+    AT_ARGUMENT_TYPE_UNSIGNED = 0,
+    AT_ARGUMENT_TYPE_SIGNED,
+    AT_ARGUMENT_TYPE_HEX,
+    AT_ARGUMENT_TYPE_STRING,
+    AT_ARGUMENT_TYPE_LAST
+} AT_argument_type_t;
+
+/*!******************************************************************
+ * \enum AT_activity_t
+ * \brief AT parser activity bits, returned by AT_get_activity().
+ *******************************************************************/
+typedef enum {
+    AT_ACTIVITY_NONE = 0x00,
+    AT_ACTIVITY_RX_LINE = 0x01,    /*! A line is partially received. */
+    AT_ACTIVITY_RX_PENDING = 0x02, /*! Received lines are waiting for AT_process(). */
+    AT_ACTIVITY_TX = 0x04,         /*! Output is staged or being sent. */
+    AT_ACTIVITY_HELP = 0x08,       /*! Help is being printed by chunks. */
+    AT_ACTIVITY_URC = 0x10,        /*! Unsolicited result codes are waiting for AT_process(). */
+    AT_ACTIVITY_PENDING = 0x20,    /*! A command is waiting for AT_complete(). */
+    AT_ACTIVITY_DATA = 0x40,       /*! A binary frame is being received. */
+    AT_ACTIVITY_WORKER = 0x80      /*! The oldest line is executed by a worker. */
+} AT_activity_t;
+
+// Wakeup delay returned by AT_get_activity() when no timeout is running.
+#define AT_WAKEUP_NONE                      0xFFFFFFFF
+
+/*!******************************************************************
+ * \struct AT_argument_t
+ * \brief AT typed argument, converted by the parser according to the command write schema.
+ *******************************************************************/
+typedef struct {
+    AT_argument_type_t type;
+    union {
+        uint32_t u32;
+        int32_t i32;
+        struct {
+            uint8_t *data;
+            uint32_t size;
+        } hex;
+        struct {
+            char *data;
+            uint32_t size;
+        } str;
+    } value;
+} AT_argument_t;
+
 /*!******************************************************************
  * \brief AT callback functions.
  * \fn AT_process_cb_t:               Will be called each time a low level IRQ is handled by the hardware interface.
  * \fn AT_command_execution_cb_t:     AT command execution callback.
  * \fn AT_command_read_cb_t:          AT command read callback.
  * \fn AT_command_write_cb_t          AT command write callback.
+ * \fn AT_command_typed_write_cb_t    AT command write callback with typed arguments.
+ * \brief Command callbacks can return AT_PENDING to complete the command later with AT_complete().
+ * \fn AT_get_timestamp_cb_t          Return a free running timestamp in any unit (statistics and data mode timeout). It is also called from the RX interrupt.
  *******************************************************************/
 typedef void (*AT_process_cb_t)(void);
 typedef AT_status_t (*AT_command_execution_cb_t)(int32_t *error_code);
 typedef AT_status_t (*AT_command_read_cb_t)(int32_t *error_code);
 typedef AT_status_t (*AT_command_write_cb_t)(uint32_t argc, char *argv[], int32_t *error_code);
+typedef AT_status_t (*AT_command_typed_write_cb_t)(uint32_t argc, AT_argument_t *argv, int32_t *error_code);
 typedef const char *(*AT_command_error_enum_to_str_cb_t)(unsigned int error_code);
+typedef uint32_t (*AT_get_timestamp_cb_t)(void);
 
 /*!******************************************************************
  * \struct AT_command_t
  * \brief AT command definition structure.
+ * \brief worker_callback (AT_WORKER option) is called when a job is queued, to wake up the workers.
+ * \brief rx_timeout is the maximum time between two bytes of a line, in the unit of the timestamp callback (0 to disable it):
+ * \brief a partial line older than the timeout is discarded when the next byte is received.
  *******************************************************************/
 typedef struct {
     uint8_t default_quiet_flag;
     uint8_t default_verbose_flag;
     uint8_t default_echo_flag;
+    uint8_t stop_on_error_flag;
     AT_process_cb_t process_callback;
+    AT_get_timestamp_cb_t get_timestamp_callback;
+    AT_process_cb_t worker_callback;
+    uint32_t rx_timeout;
 } AT_config_t;
 
+#ifdef AT_DATA_MODE
+/*!******************************************************************
+ * \brief AT data mode callback functions.
+ * \fn AT_data_cb_t:                  Will be called from the RX interrupt with each received part of the frame payload.
+ * \fn AT_data_end_cb_t:              Will be called by AT_process() at the end of the frame with the frame reception status. The returned status is printed.
+ *******************************************************************/
+typedef void (*AT_data_cb_t)(const uint8_t *data, uint32_t size);
+typedef AT_status_t (*AT_data_end_cb_t)(AT_status_t data_status, int32_t *error_code);
+
+/*!******************************************************************
+ * \struct AT_data_mode_config_t
+ * \brief AT binary data mode configuration structure.
+ * \brief After the status of the command, the host sends size bytes followed by their CRC-16/CCITT (0x1021 polynomial, 0xFFFF initial value, MSB first).
+ * \brief The timeout is the maximum time between two received bytes, in the unit of the timestamp callback (0 to disable it).
+ *******************************************************************/
+typedef struct {
+    uint32_t size;
+    uint32_t timeout;
+    AT_data_cb_t data_callback;
+    AT_data_end_cb_t end_callback;
+} AT_data_mode_config_t;
+#endif
+
 /*!******************************************************************
  * \struct AT_command_t
  * \brief AT command definition structure.
+ * \brief write_schema is an optional comma separated list of the expected write arguments:
+ * \brief   u8, u16, u32:   unsigned integer (decimal or 0x prefixed hexadecimal).
+ * \brief   i8, i16, i32:   signed integer (decimal or 0x prefixed hexadecimal).
+ * \brief   hex, hexN:      hexadecimal byte array, decoded in place (exactly N bytes if specified).
+ * \brief   str, strN:      character string (at most N characters if specified).
+ * \brief When a schema is defined, the parser checks and converts the arguments before calling typed_write_callback (or write_callback),
+ * \brief and reports AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_xxx errors with the argument position.
+ * \brief mode and resource are only used with the AT_WORKER option (resource is a number between 0 and 31).
+ * \brief cache_ttl is only used with the AT_READ_CACHE option: the replies of a successful read callback are replayed
+ * \brief without calling it during cache_ttl, in the unit of the timestamp callback (0 to disable the cache for this command).
+ * \brief help, execution_help, read_help, write_arguments and write_help should be given with the AT_HELP() macro,
+ * \brief so that they are not linked with the AT_NO_HELP option (write_arguments is then not required by a write callback).
  *******************************************************************/
 typedef struct {
     const char *syntax;
@@ -123,10 +372,294 @@ typedef struct {
     const char *write_arguments;
     const char *write_help;
     AT_command_error_enum_to_str_cb_t enum_to_str_callback;
+    const char *write_schema;
+    AT_command_typed_write_cb_t typed_write_callback;
+    AT_command_mode_t mode;
+    uint8_t resource;
+    uint32_t cache_ttl;
 } AT_command_t;
 
+/*!******************************************************************
+ * \struct AT_command_table_t
+ * \brief AT constant commands table registered in an instance.
+ * \brief The table is used in place: type_offset[type] is the position of the first command of each type.
+ *******************************************************************/
+typedef struct {
+    const AT_command_t *const *commands;
+    uint16_t type_offset[AT_COMMAND_TYPE_LAST + 1];
+#if defined(AT_STATISTICS) || defined(AT_METRICS)
+    // First statistics and metrics slot of the table, followed by one slot per position.
+    uint16_t slot_offset;
+#endif
+} AT_command_table_t;
+
+/*!******************************************************************
+ * \union AT_flags_t
+ * \brief AT instance flags.
+ *******************************************************************/
+typedef union {
+    struct {
+        uint8_t quiet :1;
+        uint8_t verbose :1;
+        uint8_t echo :1;
+        uint8_t running :1;
+        uint8_t stop_on_error :1;
+    } field;
+    uint8_t all;
+} AT_flags_t;
+
+#ifdef AT_URC
+/*!******************************************************************
+ * \struct AT_urc_t
+ * \brief AT unsolicited result code queue slot.
+ *******************************************************************/
+typedef struct {
+    char buffer[AT_URC_SIZE];
+    volatile uint8_t ready;
+} AT_urc_t;
+#endif
+
+#ifdef AT_READ_CACHE
+/*!******************************************************************
+ * \struct AT_read_cache_t
+ * \brief AT read replies cache entry.
+ *******************************************************************/
+typedef struct {
+    const AT_command_t *command;
+    uint32_t timestamp;
+    volatile uint8_t valid;
+    uint16_t size;
+    char buffer[AT_READ_CACHE_SIZE];
+} AT_read_cache_t;
+#endif
+
+/*!******************************************************************
+ * \struct AT_rx_line_t
+ * \brief AT reception line buffer.
+ *******************************************************************/
+typedef struct {
+    char buffer[AT_BUFFER_SIZE];
+    AT_line_size_t size;
+    uint8_t overflow;
+#ifdef AT_STATISTICS
+    uint32_t timestamp;
+#endif
+#ifdef AT_INCREMENTAL_PARSING
+    // Command search state, advanced by the RX interrupt for each byte.
+    uint8_t parse_state;
+    uint8_t parse_status;
+    uint8_t parse_generation;
+    AT_line_size_t parse_start;
+    AT_line_size_t parse_size;
+    AT_command_index_t parse_low;
+    AT_command_index_t parse_high;
+    AT_command_index_t parse_slot;
+#endif
+#ifdef AT_WORKER
+    // Job of a line executed by a worker, the replies are printed by AT_process() in order.
+    volatile uint8_t job_state;
+    uint8_t job_type;
+    AT_line_size_t job_start;
+    AT_line_size_t job_command_size;
+    const AT_command_t *job_command;
+    AT_status_t job_status;
+    int32_t job_error_code;
+    uint16_t job_reply_size;
+    uint16_t job_reply_reserved_size;
+    uint8_t job_reply_flag;
+    char job_reply[AT_WORKER_REPLY_SIZE];
+#endif
+} AT_rx_line_t;
+
+#ifdef AT_STATISTICS
+/*!******************************************************************
+ * \enum AT_statistics_phase_t
+ * \brief AT command processing phases.
+ *******************************************************************/
+typedef enum {
+    AT_STATISTICS_PHASE_LATENCY = 0, /*! From the end of line reception to the AT_process() entry (shared by the concatenated commands of a line). */
+    AT_STATISTICS_PHASE_LOOKUP,      /*! Command search in the index. */
+    AT_STATISTICS_PHASE_CALLBACK,    /*! Arguments parsing and command callback, including the replies it sends. */
+    AT_STATISTICS_PHASE_PRINT,       /*! Status print and TX flush (0 when another command of the same line follows). */
+    AT_STATISTICS_PHASE_LAST
+} AT_statistics_phase_t;
+
+/*!******************************************************************
+ * \struct AT_statistics_t
+ * \brief AT command timings, in the unit of the timestamp callback.
+ *******************************************************************/
+typedef struct {
+    uint32_t count;
+    uint32_t min[AT_STATISTICS_PHASE_LAST];
+    uint32_t max[AT_STATISTICS_PHASE_LAST];
+    uint32_t sum[AT_STATISTICS_PHASE_LAST];
+} AT_statistics_t;
+#endif
+
+#ifdef AT_METRICS
+/*!******************************************************************
+ * \struct AT_metrics_t
+ * \brief AT traffic counters (free running, they wrap around).
+ *******************************************************************/
+typedef struct {
+    uint32_t rx_lines;                              /*! Lines received (dropped lines are counted by rx_dropped_lines_count). */
+    uint32_t rx_overflows;                          /*! Lines longer than the RX buffer. */
+    uint32_t tx_bytes;                              /*! Bytes given to the hardware interface. */
+    uint32_t tx_writes;                             /*! Hardware interface write calls. */
+    uint32_t status_count[AT_ERROR_LAST];           /*! Printed statuses, indexed by AT_status_t. */
+    uint32_t command_hits[AT_COMMAND_LIST_SIZE + AT_TABLE_SLOTS_NUMBER];    /*! Executions of each command, indexed by its slot in the list, then by the slot of the tables commands. */
+} AT_metrics_t;
+#endif
+
+/*!******************************************************************
+ * \struct AT_HW_API_ops_t
+ * \brief AT hardware interface operations (defined in at_hw_api.h).
+ *******************************************************************/
+typedef struct AT_HW_API_ops_s AT_HW_API_ops_t;
+
+/*!******************************************************************
+ * \struct AT_handle_t
+ * \brief AT parser instance, allocated by the application.
+ * \brief All fields are private to the driver and must not be accessed directly.
+ *******************************************************************/
+typedef struct {
+    const AT_HW_API_ops_t *hw_ops;
+    void *hw_context;
+    AT_process_cb_t process_callback;
+#ifdef AT_WORKER
+    AT_process_cb_t worker_callback;
+#endif
+    AT_flags_t flags;
+    // RX lines are written by the ISR and released by AT_process (single producer, single consumer).
+    AT_rx_line_t rx_lines[AT_RX_LINES_NUMBER];
+    volatile uint8_t rx_write_count;
+    volatile uint8_t rx_read_count;
+    uint8_t rx_drop_flag;
+    volatile uint32_t rx_dropped_lines_count;
+    // Partial line reception, for the activity and the inter-byte timeout.
+    volatile uint8_t rx_partial_flag;
+    volatile uint32_t rx_timestamp;
+    uint32_t rx_timeout;
+#ifdef AT_URC
+    // Unsolicited result codes, posted from any context and printed by AT_process() between command responses.
+    AT_urc_t urc[AT_URC_NUMBER];
+    volatile uint8_t urc_write_count;
+    volatile uint8_t urc_read_count;
+#endif
+#ifdef AT_READ_CACHE
+    // Formatted replies of the cached read commands, captured while the read callback prints them.
+    AT_read_cache_t read_cache[AT_READ_CACHE_NUMBER];
+    AT_read_cache_t *read_cache_capture;
+    uint8_t read_cache_overflow;
+    uint8_t read_cache_capture_generation;
+    volatile uint8_t read_cache_generation;
+#endif
+    // TX fragments are staged in a buffer until the end of the reply.
+    uint8_t tx_buffer[AT_TX_BUFFER_SIZE];
+#ifdef AT_ASYNCHRONOUS_TX
+    // In asynchronous mode, the buffer is a ring drained by the TX done interrupt.
+    AT_tx_size_t tx_write_index;
+    volatile AT_tx_size_t tx_read_index;
+    volatile AT_tx_size_t tx_busy_size;
+    // End of the data when a reserved reply restarted from the beginning of the ring.
+    volatile AT_tx_size_t tx_wrap_index;
+    // AT_process() is called back by the TX done callback once the ring is empty.
+    volatile uint8_t tx_wait_flag;
+    // Output unit (status, help line...) suspended when the ring is full, printed again without its bytes already written.
+    uint8_t tx_unit;
+    uint8_t tx_suspended_flag;
+    uint32_t tx_unit_size;
+    uint32_t tx_skip_size;
+    // Replies of the running command which did not fit in the ring, moved to the ring as it is transmitted.
+    uint8_t tx_reply_buffer[AT_TX_REPLY_SIZE];
+    uint32_t tx_reply_size;
+#else
+    AT_tx_size_t tx_buffer_size;
+#endif
+    // Reply reserved in the TX buffer by AT_reply_begin(), until AT_reply_commit().
+    char *reply_area;
+    AT_tx_size_t reply_reserved_size;
+    const AT_command_t *current_command;
+    const AT_command_t *commands_list[AT_COMMAND_LIST_SIZE];
+    AT_command_index_t commands_count[AT_COMMAND_TYPE_LAST];
+    AT_command_index_t commands_index[AT_COMMAND_LIST_SIZE];
+    AT_line_size_t commands_syntax_size[AT_COMMAND_LIST_SIZE];
+    // Lowest slot which may be free in the list.
+    AT_command_index_t commands_free;
+    AT_command_table_t commands_tables[AT_COMMAND_TABLES_NUMBER];
+    uint8_t commands_tables_count;
+#if defined(AT_STATISTICS) || defined(AT_METRICS)
+    uint16_t tables_slots_count;
+#endif
+#ifdef AT_INCREMENTAL_PARSING
+    // Odd while the index is updated, incremented twice for each update.
+    volatile uint8_t commands_generation;
+#endif
+#ifndef AT_NO_HELP
+    // Help cursor, kept between AT_process() calls.
+    uint8_t help_flag;
+    uint8_t help_type;
+    uint8_t help_table;
+    uint32_t help_slot;
+    uint8_t help_line;
+#endif
+    AT_get_timestamp_cb_t get_timestamp_callback;
+    // First error of the commands of the line.
+    AT_status_t line_status;
+    int32_t line_error_code;
+    const AT_command_t *line_error_command;
+    // Pending command (AT_PENDING), the line is kept and resumed from the next command once completed.
+    uint8_t pending_state;
+    const AT_command_t *pending_command;
+    char *pending_next_command;
+    AT_status_t pending_status;
+    int32_t pending_error_code;
+#ifdef AT_DATA_MODE
+    // Binary frame reception, the RX interrupt bypasses lines while receiving.
+    AT_data_mode_config_t data_config;
+    volatile uint8_t data_state;
+    uint8_t data_crc_size;
+    uint16_t data_crc;
+    uint16_t data_received_crc;
+    volatile uint32_t data_remaining_size;
+    volatile uint32_t data_timestamp;
+#endif
+#ifdef AT_STATISTICS
+    // Timings of each registered command, indexed by its slot in the list, then by the slot of the tables commands.
+    uint32_t statistics_slot;
+    uint32_t statistics_timings[AT_STATISTICS_PHASE_LAST];
+    AT_statistics_t commands_statistics[AT_COMMAND_LIST_SIZE + AT_TABLE_SLOTS_NUMBER];
+#endif
+#ifdef AT_METRICS
+    // Traffic counters printed by AT!METRICS.
+    AT_metrics_t metrics;
+#ifdef AT_ASYNCHRONOUS_TX
+    // RX and TX counters printed by a suspended AT!METRICS output, which is printed again with the same values.
+    uint32_t metrics_snapshot[5];
+#endif
+#endif
+} AT_handle_t;
+
+#ifdef AT_HELP_COMPRESSED
+/*** AT global variables ***/
+
+/*!******************************************************************
+ * \var AT_HELP_DICTIONARY
+ * \brief Words of the compressed help texts, to be defined by the application (at_help_dictionary.c generated by at_generator.py --compress-help).
+ * \brief AT_HELP_DICTIONARY_SIZE is the number of words (at most 128), a help byte referencing a missing word is ignored.
+ *******************************************************************/
+extern const char *const AT_HELP_DICTIONARY[];
+extern const uint8_t AT_HELP_DICTIONARY_SIZE;
+#endif
+
 /*** AT functions ***/
 
+/*!******************************************************************
+ * \brief AT default instance functions.
+ * \brief These functions operate on the default instance, connected to the AT_HW_API_xxx() functions of at_hw_api.h.
+ * \brief When called from a command callback, AT_send_reply() and AT_flush() operate on the instance which is executing the command.
+ *******************************************************************/
+
 /*!******************************************************************
  * \fn AT_status_t AT_init(AT_config_t *config)
  * \brief Initialize AT command manager.
@@ -163,6 +696,16 @@ AT_status_t AT_register_command(const AT_command_t *command);
  *******************************************************************/
 AT_status_t AT_unregister_command(const AT_command_t *command);
 
+/*!******************************************************************
+ * \fn AT_status_t AT_register_table(const AT_command_t *const table[], uint32_t table_size)
+ * \brief Register a constant table of AT commands (see AT_register_table_ex()).
+ * \param[in]   table: Table of pointers to the commands to register.
+ * \param[in]   table_size: Number of commands in the table.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_register_table(const AT_command_t *const table[], uint32_t table_size);
+
 /*!******************************************************************
  * \fn AT_status_t AT_process(void)
  * \brief Process AT command driver.
@@ -182,6 +725,440 @@ AT_status_t AT_process(void);
  *******************************************************************/
 AT_status_t AT_send_reply(const AT_command_t *command, char *reply);
 
+/*!******************************************************************
+ * \fn AT_status_t AT_send_reply_size(const AT_command_t *command, const char *reply, uint32_t reply_size)
+ * \brief Send a reply of known size, which does not need to be null terminated (see AT_send_reply_size_ex()).
+ * \param[in]   command: Pointer to the command to send a reply. If NULL, the actual internal command will be used for the reply.
+ * \param[in]   reply: Characters to send.
+ * \param[in]   reply_size: Number of characters to send.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_send_reply_size(const AT_command_t *command, const char *reply, uint32_t reply_size);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_reply_begin(const AT_command_t *command, uint32_t size, char **reply)
+ * \brief Reserve a reply directly in the TX buffer (see AT_reply_begin_ex()).
+ * \brief With AT_ASYNCHRONOUS_TX, callers outside of a command callback must handle AT_ERROR_TX_BUSY by retrying later.
+ * \param[in]   command: Pointer to the command to send a reply. If NULL, the actual internal command will be used for the reply.
+ * \param[in]   size: Maximum number of characters of the reply.
+ * \param[out]  reply: Pointer that will contain the address where the reply must be written.
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_reply_begin(const AT_command_t *command, uint32_t size, char **reply);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_reply_commit(uint32_t reply_size)
+ * \brief Send the reply written after AT_reply_begin() (see AT_reply_commit_ex()).
+ * \param[in]   reply_size: Number of characters written.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_reply_commit(uint32_t reply_size);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_send_reply_hex(const AT_command_t *command, const uint8_t *data, uint32_t data_size)
+ * \brief Send binary data as an hexadecimal reply (see AT_send_reply_hex_ex()).
+ * \param[in]   command: Pointer to the command to send a reply. If NULL, the actual internal command will be used for the reply.
+ * \param[in]   data: Bytes to send.
+ * \param[in]   data_size: Number of bytes to send.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_send_reply_hex(const AT_command_t *command, const uint8_t *data, uint32_t data_size);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_decode_hex(const char *hex, uint32_t hex_size, uint8_t *data, uint32_t data_size)
+ * \brief Decode and validate an hexadecimal string (upper or lower case digits, without prefix) into hex_size / 2 bytes.
+ * \brief The output may be the input itself to decode in place. Parameters of type hexN are already decoded by the command schema.
+ * \param[in]   hex: Characters to decode.
+ * \param[in]   hex_size: Number of characters to decode (must be even).
+ * \param[in]   data_size: Size of the output buffer.
+ * \param[out]  data: Output buffer. If NULL, the characters are only checked.
+ * \retval      Function execution status (AT_ERROR_HEX_FORMAT for odd size or invalid characters, AT_ERROR_HEX_SIZE if the output buffer is too small).
+ *******************************************************************/
+AT_status_t AT_decode_hex(const char *hex, uint32_t hex_size, uint8_t *data, uint32_t data_size);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_encode_hex(const uint8_t *data, uint32_t data_size, char *hex, uint32_t hex_size)
+ * \brief Encode bytes as a null terminated string of upper case hexadecimal digits.
+ * \param[in]   data: Bytes to encode.
+ * \param[in]   data_size: Number of bytes to encode.
+ * \param[in]   hex_size: Size of the output buffer (at least 2 * data_size + 1).
+ * \param[out]  hex: Output string.
+ * \retval      Function execution status (AT_ERROR_HEX_SIZE if the output buffer is too small).
+ *******************************************************************/
+AT_status_t AT_encode_hex(const uint8_t *data, uint32_t data_size, char *hex, uint32_t hex_size);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_flush(void)
+ * \brief Write the output staged in the TX buffer over the hardware interface.
+ * \brief Output is automatically flushed when the buffer is full, at the end of each command status and after replies sent outside of a command.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_flush(void);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_get_rx_dropped_lines(uint32_t *dropped_lines)
+ * \brief Get the number of lines dropped because all RX line buffers were waiting for processing.
+ * \param[in]   none
+ * \param[out]  dropped_lines: Pointer that will contain the number of dropped lines since the initialization.
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_get_rx_dropped_lines(uint32_t *dropped_lines);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_get_rx_free_lines(uint32_t *free_lines)
+ * \brief Get the number of RX line buffers which can still receive a complete line without dropping it.
+ * \brief Block reception drivers can use it to hold the next lines (flow control) instead of dropping them.
+ * \param[in]   none
+ * \param[out]  free_lines: Pointer that will contain the number of free RX line buffers.
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_get_rx_free_lines(uint32_t *free_lines);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_get_activity(uint32_t *activity, uint32_t *wakeup_delay)
+ * \brief Get the activity of the default instance (see AT_get_activity_ex()).
+ * \param[in]   none
+ * \param[out]  activity: Pointer that will contain the AT_ACTIVITY_xxx bits.
+ * \param[out]  wakeup_delay: Pointer that will contain the delay before the next timeout (AT_WAKEUP_NONE if none).
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_get_activity(uint32_t *activity, uint32_t *wakeup_delay);
+
+/*!******************************************************************
+ * \fn uint8_t AT_can_sleep(void)
+ * \brief Check if the default instance can sleep (see AT_can_sleep_ex()).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      1 if the MCU can sleep until the next interrupt, 0 otherwise.
+ *******************************************************************/
+uint8_t AT_can_sleep(void);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_complete(const AT_command_t *command, AT_status_t status, int32_t error_code)
+ * \brief Complete a command which returned AT_PENDING (see AT_complete_ex()).
+ * \brief When called from a command callback, it operates on the instance which is executing the command, otherwise on the default instance.
+ * \param[in]   command: Pointer to the pending command. If NULL, the pending command of the instance is completed.
+ * \param[in]   status: Final status of the command.
+ * \param[in]   error_code: Error code printed with the status.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_complete(const AT_command_t *command, AT_status_t status, int32_t error_code);
+
+#ifdef AT_WORKER
+/*!******************************************************************
+ * \fn AT_status_t AT_worker_process(void)
+ * \brief Execute one queued job of the default instance (see AT_worker_process_ex()).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_worker_process(void);
+#endif
+
+#ifdef AT_URC
+/*!******************************************************************
+ * \fn AT_status_t AT_post_urc(const char *urc)
+ * \brief Post an unsolicited result code to the default instance (see AT_post_urc_ex()).
+ * \param[in]   urc: Null terminated line to print, without end of line.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_post_urc(const char *urc);
+#endif
+
+#ifdef AT_READ_CACHE
+/*!******************************************************************
+ * \fn AT_status_t AT_invalidate(const AT_command_t *command)
+ * \brief Invalidate the cached read replies of the instance executing the current command, or of the default instance (see AT_invalidate_ex()).
+ * \param[in]   command: Pointer to the command (NULL to invalidate all commands).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_invalidate(const AT_command_t *command);
+#endif
+
+#ifdef AT_DATA_MODE
+/*!******************************************************************
+ * \fn AT_status_t AT_enter_data_mode(AT_data_mode_config_t *config)
+ * \brief Switch the reception of the instance executing the current command to a binary frame (see AT_enter_data_mode_ex()).
+ * \param[in]   config: Pointer to the data mode configuration.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_enter_data_mode(AT_data_mode_config_t *config);
+#endif
+
+/*!******************************************************************
+ * \brief AT instance functions.
+ * \brief Each instance has its own context and hardware interface operations. Different instances can be processed by different threads
+ * \brief (AT_MULTITHREAD option), but the functions of one instance must not be called concurrently.
+ *******************************************************************/
+
+/*!******************************************************************
+ * \fn AT_status_t AT_init_ex(AT_handle_t *handle, AT_config_t *config, const AT_HW_API_ops_t *hw_ops, void *hw_context)
+ * \brief Initialize an AT command manager instance.
+ * \param[in]   handle: Pointer to the instance to initialize.
+ * \param[in]   config: Pointer to the configuration structure.
+ * \param[in]   hw_ops: Pointer to the hardware interface operations of the instance.
+ * \param[in]   hw_context: Pointer given to each hardware interface operation.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_init_ex(AT_handle_t *handle, AT_config_t *config, const AT_HW_API_ops_t *hw_ops, void *hw_context);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_de_init_ex(AT_handle_t *handle)
+ * \brief Release an AT command manager instance.
+ * \param[in]   handle: Pointer to the instance.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_de_init_ex(AT_handle_t *handle);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_register_command_ex(AT_handle_t *handle, const AT_command_t *command)
+ * \brief Register an AT command in an instance.
+ * \param[in]   handle: Pointer to the instance.
+ * \param[in]   command: Pointer to the command to register.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_register_command_ex(AT_handle_t *handle, const AT_command_t *command);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_unregister_command_ex(AT_handle_t *handle, const AT_command_t *command)
+ * \brief Unregister an AT command from an instance.
+ * \param[in]   handle: Pointer to the instance.
+ * \param[in]   command: Pointer to the command to unregister.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_unregister_command_ex(AT_handle_t *handle, const AT_command_t *command);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_register_table_ex(AT_handle_t *handle, const AT_command_t *const table[], uint32_t table_size)
+ * \brief Register a constant table of AT commands in an instance, without copying it.
+ * \brief The table must be sorted by type, then by syntax in strcmp() order (without duplicates). It is checked but not sorted by the driver.
+ * \brief Commands registered with AT_register_command_ex() are searched first: they override table commands with the same syntax.
+ * \brief With AT_STATISTICS or AT_METRICS, each command of the table takes one of the AT_TABLE_SLOTS_NUMBER statistics and metrics slots of the instance.
+ * \param[in]   handle: Pointer to the instance.
+ * \param[in]   table: Table of pointers to the commands to register, kept by the driver (can be stored in flash).
+ * \param[in]   table_size: Number of commands in the table.
+ * \param[out]  none
+ * \retval      Function execution status (AT_ERROR_COMMANDS_TABLES_FULL if no table or slots are left).
+ *******************************************************************/
+AT_status_t AT_register_table_ex(AT_handle_t *handle, const AT_command_t *const table[], uint32_t table_size);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_process_ex(AT_handle_t *handle)
+ * \brief Process an AT command manager instance.
+ * \param[in]   handle: Pointer to the instance.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_process_ex(AT_handle_t *handle);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_send_reply_ex(AT_handle_t *handle, const AT_command_t *command, char *reply)
+ * \brief Send a reply over the hardware interface of an instance.
+ * \brief With AT_ASYNCHRONOUS_TX, the replies of a running command which do not fit in the TX ring are staged in AT_TX_REPLY_SIZE bytes and written once it is transmitted.
+ * \brief Outside of a command callback (pending command), the reply is written entirely in the free space of the TX ring, or not at all (AT_ERROR_TX_BUSY).
+ * \param[in]   handle: Pointer to the instance.
+ * \param[in]   command: Pointer to the command to send a reply. If NULL, the actual internal command will be used for the reply.
+ * \param[in]   reply: String to send.
+ * \param[out]  none
+ * \retval      Function execution status (AT_ERROR_TX_BUFFER_SIZE if the replies of the command do not fit in the TX ring and staged replies, AT_ERROR_TX_BUSY if the ring is not empty enough outside of a command).
+ *******************************************************************/
+AT_status_t AT_send_reply_ex(AT_handle_t *handle, const AT_command_t *command, char *reply);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_send_reply_size_ex(AT_handle_t *handle, const AT_command_t *command, const char *reply, uint32_t reply_size)
+ * \brief Send a reply of known size over the hardware interface of an instance, without searching the end of the string.
+ * \param[in]   handle: Pointer to the instance.
+ * \param[in]   command: Pointer to the command to send a reply. If NULL, the actual internal command will be used for the reply.
+ * \param[in]   reply: Characters to send, not necessarily null terminated.
+ * \param[in]   reply_size: Number of characters to send.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_send_reply_size_ex(AT_handle_t *handle, const AT_command_t *command, const char *reply, uint32_t reply_size);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_reply_begin_ex(AT_handle_t *handle, const AT_command_t *command, uint32_t size, char **reply)
+ * \brief Reserve a reply of at most size characters directly in the TX buffer of an instance, after the command header.
+ * \brief The reply is formatted in place and sent by AT_reply_commit_ex(), without intermediate buffer nor copy.
+ * \brief Nothing else must be printed on the instance until the commit. Staged output is flushed if needed to get a contiguous area.
+ * \brief With AT_ASYNCHRONOUS_TX, the area restarts from the beginning of the TX buffer when its end is too short, the parser does not wait for the transfer.
+ * \brief When the ring is busy, the area of a running command is reserved after its staged replies (AT_TX_REPLY_SIZE bytes), see AT_send_reply_ex().
+ * \brief Outside of a command callback (pending command), AT_ERROR_TX_BUSY is returned when the ring is not empty enough and the reply must be sent later.
+ * \param[in]   handle: Pointer to the instance.
+ * \param[in]   command: Pointer to the command to send a reply. If NULL, the actual internal command will be used for the reply.
+ * \param[in]   size: Maximum number of characters of the reply (header and end of line must also fit in the TX buffer).
+ * \param[out]  reply: Pointer that will contain the address where the reply must be written.
+ * \retval      Function execution status (AT_ERROR_REPLY_STATE if a reply is already reserved, AT_ERROR_TX_BUFFER_SIZE if the reply does not fit, AT_ERROR_TX_BUSY if the TX ring is busy outside of a command).
+ *******************************************************************/
+AT_status_t AT_reply_begin_ex(AT_handle_t *handle, const AT_command_t *command, uint32_t size, char **reply);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_reply_commit_ex(AT_handle_t *handle, uint32_t reply_size)
+ * \brief Send the reply written in the area given by AT_reply_begin_ex(), followed by the end of line.
+ * \param[in]   handle: Pointer to the instance.
+ * \param[in]   reply_size: Number of characters written (at most the reserved size).
+ * \param[out]  none
+ * \retval      Function execution status (AT_ERROR_REPLY_STATE if no reply is reserved).
+ *******************************************************************/
+AT_status_t AT_reply_commit_ex(AT_handle_t *handle, uint32_t reply_size);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_send_reply_hex_ex(AT_handle_t *handle, const AT_command_t *command, const uint8_t *data, uint32_t data_size)
+ * \brief Send binary data as an hexadecimal reply of an instance, encoded directly in the TX buffer (or job reply buffer).
+ * \brief The encoded reply (2 characters per byte) must fit in the TX buffer with its header and end of line.
+ * \param[in]   handle: Pointer to the instance.
+ * \param[in]   command: Pointer to the command to send a reply. If NULL, the actual internal command will be used for the reply.
+ * \param[in]   data: Bytes to send.
+ * \param[in]   data_size: Number of bytes to send.
+ * \param[out]  none
+ * \retval      Function execution status (as AT_reply_begin_ex(), AT_ERROR_TX_BUSY must be handled outside of a command with AT_ASYNCHRONOUS_TX).
+ *******************************************************************/
+AT_status_t AT_send_reply_hex_ex(AT_handle_t *handle, const AT_command_t *command, const uint8_t *data, uint32_t data_size);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_flush_ex(AT_handle_t *handle)
+ * \brief Write the output staged in the TX buffer of an instance.
+ * \param[in]   handle: Pointer to the instance.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_flush_ex(AT_handle_t *handle);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_complete_ex(AT_handle_t *handle, const AT_command_t *command, AT_status_t status, int32_t error_code)
+ * \brief Complete a command which returned AT_PENDING: its status is printed by the next AT_process_ex() call, then the next commands of the line are executed.
+ * \brief Until then, the following lines are kept in the RX line buffers and replies can still be sent with AT_send_reply_ex().
+ * \brief It must be called from the context of AT_process_ex() (main loop or command callback, even before returning AT_PENDING) and not from an interrupt.
+ * \param[in]   handle: Pointer to the instance.
+ * \param[in]   command: Pointer to the pending command. If NULL, the pending command of the instance is completed.
+ * \param[in]   status: Final status of the command.
+ * \param[in]   error_code: Error code printed with the status.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_complete_ex(AT_handle_t *handle, const AT_command_t *command, AT_status_t status, int32_t error_code);
+
+#ifdef AT_WORKER
+/*!******************************************************************
+ * \fn AT_status_t AT_worker_process_ex(AT_handle_t *handle)
+ * \brief Execute one queued job of an instance, to be called by each worker thread after the worker callback.
+ * \brief Lines made of a single AT_COMMAND_MODE_WORKER or AT_COMMAND_MODE_REENTRANT command are queued by AT_process_ex() as jobs,
+ * \brief ahead of the line being printed, until the next inline line. Jobs are claimed without lock, so several workers can run in parallel:
+ * \brief worker commands of the same resource are executed one by one in the reception order, reentrant commands at any time.
+ * \brief The replies of a job are buffered (AT_WORKER_REPLY_SIZE bytes) and printed with its status by AT_process_ex(), in the reception order.
+ * \brief Job callbacks must return their final status (AT_PENDING and data mode are not supported).
+ * \param[in]   handle: Pointer to the instance.
+ * \param[out]  none
+ * \retval      Function execution status (AT_ERROR_WORKER_NO_JOB if no job was queued).
+ *******************************************************************/
+AT_status_t AT_worker_process_ex(AT_handle_t *handle);
+#endif
+
+/*!******************************************************************
+ * \fn AT_status_t AT_get_rx_dropped_lines_ex(AT_handle_t *handle, uint32_t *dropped_lines)
+ * \brief Get the number of lines dropped by an instance because all RX line buffers were waiting for processing.
+ * \param[in]   handle: Pointer to the instance.
+ * \param[out]  dropped_lines: Pointer that will contain the number of dropped lines since the initialization.
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_get_rx_dropped_lines_ex(AT_handle_t *handle, uint32_t *dropped_lines);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_get_rx_free_lines_ex(AT_handle_t *handle, uint32_t *free_lines)
+ * \brief Get the number of RX line buffers of an instance which can still receive a complete line without dropping it.
+ * \param[in]   handle: Pointer to the instance.
+ * \param[out]  free_lines: Pointer that will contain the number of free RX line buffers.
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_get_rx_free_lines_ex(AT_handle_t *handle, uint32_t *free_lines);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_get_activity_ex(AT_handle_t *handle, uint32_t *activity, uint32_t *wakeup_delay)
+ * \brief Get the activity of an instance, to decide if the MCU can enter a low power mode.
+ * \brief The wakeup delay is the time left, in the unit of the timestamp callback, before the partial line is discarded by the RX timeout
+ * \brief or before AT_process_ex() must be called to report a data mode timeout (0 if it is already over).
+ * \param[in]   handle: Pointer to the instance.
+ * \param[out]  activity: Pointer that will contain the AT_ACTIVITY_xxx bits.
+ * \param[out]  wakeup_delay: Pointer that will contain the delay before the next timeout (AT_WAKEUP_NONE if none).
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_get_activity_ex(AT_handle_t *handle, uint32_t *activity, uint32_t *wakeup_delay);
+
+/*!******************************************************************
+ * \fn uint8_t AT_can_sleep_ex(AT_handle_t *handle)
+ * \brief Check if an instance can sleep: no line is being received or waiting for processing, no output is being sent,
+ * \brief no help or unsolicited result code is waiting to be printed and no timeout is over.
+ * \brief Pending commands, data frames and worker jobs do not prevent sleeping: AT_complete(), the RX interrupt or the workers call the process callback.
+ * \brief The MCU can then sleep until the next interrupt, or at most the wakeup delay given by AT_get_activity_ex().
+ * \param[in]   handle: Pointer to the instance.
+ * \param[out]  none
+ * \retval      1 if the MCU can sleep until the next interrupt, 0 otherwise (or if the handle is NULL).
+ *******************************************************************/
+uint8_t AT_can_sleep_ex(AT_handle_t *handle);
+
+#ifdef AT_URC
+/*!******************************************************************
+ * \fn AT_status_t AT_post_urc_ex(AT_handle_t *handle, const char *urc)
+ * \brief Post an unsolicited result code (asynchronous event) to an instance.
+ * \brief The code is copied in a bounded queue and printed by AT_process_ex() between two command responses, so it never interleaves with a reply.
+ * \brief It can be called from interrupts and from other threads (lock-free with GCC atomic builtins, single producer otherwise).
+ * \param[in]   handle: Pointer to the instance.
+ * \param[in]   urc: Null terminated line to print, without end of line (at most AT_URC_SIZE - 1 characters).
+ * \param[out]  none
+ * \retval      Function execution status (AT_ERROR_URC_QUEUE_FULL when all slots are waiting to be printed).
+ *******************************************************************/
+AT_status_t AT_post_urc_ex(AT_handle_t *handle, const char *urc);
+#endif
+
+#ifdef AT_READ_CACHE
+/*!******************************************************************
+ * \fn AT_status_t AT_invalidate_ex(AT_handle_t *handle, const AT_command_t *command)
+ * \brief Invalidate the cached read replies of a command, so that its read callback is called by the next read.
+ * \brief It must be called when the value read by the command changes before the end of its cache_ttl (for example by its write callback).
+ * \brief Without timestamp callback, cached replies stay valid until they are invalidated.
+ * \param[in]   handle: Pointer to the instance.
+ * \param[in]   command: Pointer to the command (NULL to invalidate all commands).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_invalidate_ex(AT_handle_t *handle, const AT_command_t *command);
+#endif
+
+#ifdef AT_DATA_MODE
+/*!******************************************************************
+ * \fn AT_status_t AT_enter_data_mode_ex(AT_handle_t *handle, AT_data_mode_config_t *config)
+ * \brief Switch the instance reception to a binary frame. Must be called from a command callback: the frame is expected after the status of the command.
+ * \brief The process callback is called at the end of the frame. While receiving, AT_process_ex() must also be called periodically to check the timeout.
+ * \param[in]   handle: Pointer to the instance.
+ * \param[in]   config: Pointer to the data mode configuration.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_enter_data_mode_ex(AT_handle_t *handle, AT_data_mode_config_t *config);
+#endif
+
+/*!******************************************************************
+ * \fn AT_handle_t *AT_get_current_handle(void)
+ * \brief Get the instance which is executing a command (to be used in command callbacks).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Pointer to the instance executing a command in the calling thread, or the default instance.
+ *******************************************************************/
+AT_handle_t *AT_get_current_handle(void);
+
 /*!******************************************************************
  * \fn void AT_check_status(error)
  * \brief Generic macro to check a MCAL function status and exit.
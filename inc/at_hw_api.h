@@ -45,19 +45,74 @@
 /*!******************************************************************
  * \brief AT callback functions.
  * \fn AT_HW_API_rx_irq_cb_t:         Will be called on byte reception interrupt.
+ * \fn AT_HW_API_rx_block_cb_t:       Will be called on block reception (DMA transfer, idle line, read() call...). Null bytes are not filtered.
+ * \fn AT_HW_API_tx_done_cb_t:        Will be called when the transfer started by AT_HW_API_write_async() is complete (AT_ASYNCHRONOUS_TX only).
  *******************************************************************/
 typedef void (*AT_HW_API_rx_irq_cb_t)(uint8_t data);
+typedef void (*AT_HW_API_rx_block_cb_t)(const uint8_t *data, uint32_t size);
+#ifdef AT_ASYNCHRONOUS_TX
+typedef void (*AT_HW_API_tx_done_cb_t)(void);
+#endif
 
 /*!******************************************************************
  * \struct AT_HW_API_config_t
  * \brief AT hardware interface configuration structure.
+ * \note Both reception callbacks are always provided: the hardware interface can use the one that fits its driver, but they must not be called concurrently.
  *******************************************************************/
 typedef struct {
     AT_HW_API_rx_irq_cb_t rx_irq_callback;
+    AT_HW_API_rx_block_cb_t rx_block_callback;
+#ifdef AT_ASYNCHRONOUS_TX
+    AT_HW_API_tx_done_cb_t tx_done_callback;
+#endif
 } AT_HW_API_config_t;
 
+/*!******************************************************************
+ * \brief AT instance callback functions.
+ * \fn AT_HW_API_rx_irq_ex_cb_t:      Will be called on byte reception interrupt.
+ * \fn AT_HW_API_rx_block_ex_cb_t:    Will be called on block reception. Null bytes are not filtered.
+ * \fn AT_HW_API_tx_done_ex_cb_t:     Will be called when the transfer started by the write_async operation is complete (AT_ASYNCHRONOUS_TX only).
+ *******************************************************************/
+typedef void (*AT_HW_API_rx_irq_ex_cb_t)(AT_handle_t *handle, uint8_t data);
+typedef void (*AT_HW_API_rx_block_ex_cb_t)(AT_handle_t *handle, const uint8_t *data, uint32_t size);
+#ifdef AT_ASYNCHRONOUS_TX
+typedef void (*AT_HW_API_tx_done_ex_cb_t)(AT_handle_t *handle);
+#endif
+
+/*!******************************************************************
+ * \struct AT_HW_API_ex_config_t
+ * \brief AT instance hardware interface configuration structure.
+ * \brief The handle must be given back to each callback.
+ *******************************************************************/
+typedef struct {
+    AT_handle_t *handle;
+    AT_HW_API_rx_irq_ex_cb_t rx_irq_callback;
+    AT_HW_API_rx_block_ex_cb_t rx_block_callback;
+#ifdef AT_ASYNCHRONOUS_TX
+    AT_HW_API_tx_done_ex_cb_t tx_done_callback;
+#endif
+} AT_HW_API_ex_config_t;
+
+/*!******************************************************************
+ * \struct AT_HW_API_ops_t
+ * \brief AT instance hardware interface operations.
+ * \brief Each operation receives the hw_context pointer given to AT_init_ex(), and has the same behavior as the corresponding AT_HW_API_xxx() function.
+ *******************************************************************/
+struct AT_HW_API_ops_s {
+    AT_status_t (*init)(void *hw_context, AT_HW_API_ex_config_t *hw_api_config);
+    AT_status_t (*de_init)(void *hw_context);
+    AT_status_t (*write)(void *hw_context, uint8_t *data, uint32_t data_size_bytes);
+#ifdef AT_ASYNCHRONOUS_TX
+    AT_status_t (*write_async)(void *hw_context, uint8_t *data, uint32_t data_size_bytes);
+#endif
+};
+
 /*** AT HW API functions ***/
 
+/*!******************************************************************
+ * \brief Hardware interface of the default instance (AT_init(), AT_process()...).
+ *******************************************************************/
+
 /*!******************************************************************
  * \fn AT_status_t AT_HW_API_init(AT_HW_API_config_t *hw_api_config)
  * \brief Initialize AT hardware interface.
@@ -86,4 +141,19 @@ AT_status_t AT_HW_API_de_init(void);
  *******************************************************************/
 AT_status_t AT_HW_API_write(uint8_t *data, uint32_t data_size_bytes);
 
+#ifdef AT_ASYNCHRONOUS_TX
+/*!******************************************************************
+ * \fn AT_status_t AT_HW_API_write_async(uint8_t *data, uint32_t data_size_bytes)
+ * \brief Start sending data over AT hardware interface without waiting for the end of the transfer.
+ * \brief The tx_done_callback given at initialization must be called once all bytes have been sent.
+ * \brief The callback must not be called concurrently with AT_process(): use a TX complete interrupt, or call it from the same thread (from this function, or later once AT_process() returned).
+ * \brief The parser never waits for the callback: when its TX buffer is full, AT_process() returns and the output is continued when the process_callback is called by the tx_done_callback.
+ * \param[in]   data: Byte array to send. It remains valid until the tx_done_callback is called.
+ * \param[in]   data_size_bytes: Number of bytes to send.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_HW_API_write_async(uint8_t *data, uint32_t data_size_bytes);
+#endif
+
 #endif /* __AT_HW_API_H__ */
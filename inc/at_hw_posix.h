@@ -0,0 +1,232 @@
+/*!*****************************************************************
+ * \file    at_hw_posix.h
+ * \brief   AT POSIX hardware interface (tty, pty and sockets).
+ *******************************************************************
+ * \copyright
+ *
+ * Copyright (c) 2024, UnaBiz SAS
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  1 Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  2 Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *  3 Neither the name of UnaBiz SAS nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *******************************************************************/
+
+#ifndef __AT_HW_POSIX_H__
+#define __AT_HW_POSIX_H__
+
+#include "at.h"
+#include "at_hw_api.h"
+#include "stdint.h"
+
+/*** AT HW POSIX macros ***/
+
+// Size of the bytes read at once from each file descriptor.
+#ifndef AT_HW_POSIX_RX_BUFFER_SIZE
+#define AT_HW_POSIX_RX_BUFFER_SIZE          512
+#endif
+// Size of the output coalesced between two writev() calls of each port.
+#ifndef AT_HW_POSIX_TX_BUFFER_SIZE
+#define AT_HW_POSIX_TX_BUFFER_SIZE          1024
+#endif
+// Number of events returned by each epoll_wait() call.
+#ifndef AT_HW_POSIX_EVENTS_NUMBER
+#define AT_HW_POSIX_EVENTS_NUMBER           64
+#endif
+// Number of AT_process_ex() calls of a port before processing the next ports.
+#ifndef AT_HW_POSIX_PROCESS_MAX
+#define AT_HW_POSIX_PROCESS_MAX             8
+#endif
+
+/*** AT HW POSIX structures ***/
+
+typedef struct AT_HW_POSIX_port_s AT_HW_POSIX_port_t;
+typedef struct AT_HW_POSIX_loop_s AT_HW_POSIX_loop_t;
+
+/*!******************************************************************
+ * \brief AT POSIX port callback functions.
+ * \fn AT_HW_POSIX_close_cb_t:        Will be called by AT_HW_POSIX_loop_run() once the port is removed from the loop (end of file or error of the file descriptor).
+ *******************************************************************/
+typedef void (*AT_HW_POSIX_close_cb_t)(AT_HW_POSIX_port_t *port);
+
+/*!******************************************************************
+ * \struct AT_HW_POSIX_port_s
+ * \brief AT POSIX port: a parser instance connected to a file descriptor.
+ * \brief fd, write_timeout_ms, skip_lf_flag, close_callback and user_data are set by the application, then the port is given
+ * \brief as hw_context to AT_init_ex() with AT_HW_POSIX_OPS and added to a loop. The other fields are private.
+ * \brief The file descriptor is set in non-blocking mode, it is not closed by the port.
+ * \brief write_timeout_ms is the maximum time waiting for the file descriptor when the TX buffer is full (0 to wait forever).
+ * \brief skip_lf_flag ignores the line feeds at the start of the lines (CR LF terminated lines, not compatible with AT_DATA_MODE).
+ *******************************************************************/
+struct AT_HW_POSIX_port_s {
+    int fd;
+    uint32_t write_timeout_ms;
+    uint8_t skip_lf_flag;
+    AT_HW_POSIX_close_cb_t close_callback;
+    void *user_data;
+    // Private fields.
+    AT_HW_API_ex_config_t hw_config;
+    AT_HW_POSIX_loop_t *loop;
+    AT_HW_POSIX_port_t *next;
+    AT_HW_POSIX_port_t *active_next;
+    uint32_t events;
+    uint8_t active_flag;
+    uint8_t closed_flag;
+    uint8_t partial_flag;
+    uint8_t rx_buffer[AT_HW_POSIX_RX_BUFFER_SIZE];
+    uint32_t rx_offset;
+    uint32_t rx_size;
+    uint8_t tx_buffer[AT_HW_POSIX_TX_BUFFER_SIZE];
+    uint32_t tx_read_index;
+    uint32_t tx_size;
+};
+
+/*!******************************************************************
+ * \struct AT_HW_POSIX_loop_s
+ * \brief AT POSIX event loop: the ports of a thread, waited with epoll. All fields are private.
+ *******************************************************************/
+struct AT_HW_POSIX_loop_s {
+    int epoll_fd;
+    int event_fd;
+    AT_HW_POSIX_port_t *ports;
+    // Ports to process by the current call, and ports to process by the next one.
+    AT_HW_POSIX_port_t *active;
+    AT_HW_POSIX_port_t *busy;
+};
+
+/*** AT HW POSIX global variables ***/
+
+/*!******************************************************************
+ * \var AT_HW_POSIX_OPS
+ * \brief Hardware operations of the POSIX ports, given to AT_init_ex() with the port as hw_context.
+ * \brief The output of each port is copied in its TX buffer and written by a single writev() call at the end of each loop iteration.
+ * \brief With AT_ASYNCHRONOUS_TX, the transfers are completed (TX done callback) as soon as they are copied.
+ *******************************************************************/
+extern const AT_HW_API_ops_t AT_HW_POSIX_OPS;
+
+/*** AT HW POSIX functions ***/
+
+/*!******************************************************************
+ * \fn AT_status_t AT_HW_POSIX_open_tty(const char *path, uint32_t baud_rate, int *fd)
+ * \brief Open a serial port in raw mode (8 bits, no parity, 1 stop bit, no flow control).
+ * \param[in]   path: Path of the serial port device.
+ * \param[in]   baud_rate: Baud rate (0 to keep the current one).
+ * \param[out]  fd: Pointer that will contain the file descriptor.
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_HW_POSIX_open_tty(const char *path, uint32_t baud_rate, int *fd);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_HW_POSIX_open_pty(int *fd, int *slave_fd, char *slave_name, uint32_t slave_name_size)
+ * \brief Create a pseudo terminal in raw mode, so that a host program opens its slave side as a serial port (device simulators).
+ * \brief The slave side is kept open by slave_fd, otherwise the master side is hung up while no host program has opened it.
+ * \param[in]   slave_name_size: Size of the slave_name buffer.
+ * \param[out]  fd: Pointer that will contain the file descriptor of the master side, to be used by the port.
+ * \param[out]  slave_fd: Pointer that will contain the file descriptor of the slave side, to be closed with the master side.
+ * \param[out]  slave_name: Buffer that will contain the path of the slave side.
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_HW_POSIX_open_pty(int *fd, int *slave_fd, char *slave_name, uint32_t slave_name_size);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_HW_POSIX_loop_init(AT_HW_POSIX_loop_t *loop)
+ * \brief Initialize an event loop.
+ * \param[in]   loop: Pointer to the loop.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_HW_POSIX_loop_init(AT_HW_POSIX_loop_t *loop);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_HW_POSIX_loop_de_init(AT_HW_POSIX_loop_t *loop)
+ * \brief Release an event loop (the remaining ports are removed without calling their close callback).
+ * \param[in]   loop: Pointer to the loop.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_HW_POSIX_loop_de_init(AT_HW_POSIX_loop_t *loop);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_HW_POSIX_loop_add(AT_HW_POSIX_loop_t *loop, AT_HW_POSIX_port_t *port)
+ * \brief Add a port initialized by AT_init_ex() to a loop.
+ * \param[in]   loop: Pointer to the loop.
+ * \param[in]   port: Pointer to the port.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_HW_POSIX_loop_add(AT_HW_POSIX_loop_t *loop, AT_HW_POSIX_port_t *port);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_HW_POSIX_loop_remove(AT_HW_POSIX_port_t *port)
+ * \brief Remove a port from its loop (the close callback is not called). It is also removed by AT_de_init_ex().
+ * \param[in]   port: Pointer to the port.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_HW_POSIX_loop_remove(AT_HW_POSIX_port_t *port);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_HW_POSIX_loop_run(AT_HW_POSIX_loop_t *loop, int32_t timeout_ms)
+ * \brief Wait for the ports events, read the received bytes by blocks, process the instances and write their output.
+ * \brief The received lines are held in the port while all the RX line buffers of the instance are busy, instead of being dropped.
+ * \brief Each instance is processed at most AT_HW_POSIX_PROCESS_MAX times per call: the call does not wait while an instance still has work to do.
+ * \brief All the ports are processed once when the timeout is over, so timeout_ms is the resolution of the parser timeouts.
+ * \brief Each loop must be run by a single thread: several loops of different threads need AT_MULTITHREAD.
+ * \param[in]   loop: Pointer to the loop.
+ * \param[in]   timeout_ms: Maximum waiting time in milliseconds (-1 to wait forever).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_HW_POSIX_loop_run(AT_HW_POSIX_loop_t *loop, int32_t timeout_ms);
+
+/*!******************************************************************
+ * \fn AT_status_t AT_HW_POSIX_loop_wakeup(AT_HW_POSIX_loop_t *loop)
+ * \brief Wake up a loop from any thread or signal handler, so that all its ports are processed.
+ * \brief It can be called by the process_callback of AT_config_t, after AT_complete_ex() or AT_post_urc_ex() from another thread.
+ * \param[in]   loop: Pointer to the loop.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+AT_status_t AT_HW_POSIX_loop_wakeup(AT_HW_POSIX_loop_t *loop);
+
+/*!******************************************************************
+ * \fn int AT_HW_POSIX_loop_get_fd(AT_HW_POSIX_loop_t *loop)
+ * \brief Get the file descriptor of a loop, readable when AT_HW_POSIX_loop_run() has events to handle (to nest the loop in another one).
+ * \param[in]   loop: Pointer to the loop.
+ * \param[out]  none
+ * \retval      File descriptor of the loop (-1 if the loop is null).
+ *******************************************************************/
+int AT_HW_POSIX_loop_get_fd(AT_HW_POSIX_loop_t *loop);
+
+/*!******************************************************************
+ * \fn uint8_t AT_HW_POSIX_loop_is_busy(AT_HW_POSIX_loop_t *loop)
+ * \brief Check if ports still have work to do: a nesting loop must call AT_HW_POSIX_loop_run() again without waiting for the loop file descriptor.
+ * \param[in]   loop: Pointer to the loop.
+ * \param[out]  none
+ * \retval      1 if ports have to be processed, 0 otherwise.
+ *******************************************************************/
+uint8_t AT_HW_POSIX_loop_is_busy(AT_HW_POSIX_loop_t *loop);
+
+#endif /* __AT_HW_POSIX_H__ */
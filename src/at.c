@@ -37,15 +37,10 @@
 #include "at.h"
 
 #include "at_hw_api.h"
-#include "stdio.h"
 #include "string.h"
 
 /*** AT local macros ***/
 
-#define AT_BUFFER_SIZE                      128
-
-#define AT_COMMAND_LIST_SIZE                64
-
 #define AT_HEADER                           "AT"
 
 #define AT_COMMAND_MARKER_END               '\r'
@@ -58,35 +53,163 @@
 #define AT_COMMAND_HEADER_DEBUG             '!'
 #define AT_COMMAND_HEADER_HELP              "        -> "
 
+#define AT_COMMAND_SEPARATOR                ';'
 #define AT_COMMAND_PARAMETER_SEPARATOR      ','
-#define AT_COMMAND_PARAMETER_MAX_NUMBER     10
+#define AT_COMMAND_PARAMETER_QUOTE          '"'
 
 #define AT_REPLY_END                        "\r\n"
 
+#define AT_STATUS_UNKNOWN                   "UNKNOWN:"
+#define AT_NUMBER_TEXT_SIZE                 11
+
+// Commands of the constant tables have no slot in the list.
+#define AT_TABLE_SLOT                       AT_COMMAND_LIST_SIZE
+#define AT_TABLE_SIZE_MAX                   0xFFFF
+
+// Activities which need the MCU (or AT_process) to stay awake.
+#define AT_ACTIVITY_BUSY_MASK               (AT_ACTIVITY_RX_LINE | AT_ACTIVITY_RX_PENDING | AT_ACTIVITY_TX | AT_ACTIVITY_HELP | AT_ACTIVITY_URC)
+
+#ifdef AT_STATISTICS
+#define AT_STATISTICS_NO_SLOT               (AT_COMMAND_LIST_SIZE + AT_TABLE_SLOTS_NUMBER)
+#endif
+
+#ifdef AT_DATA_MODE
+#define AT_DATA_CRC_POLYNOMIAL              0x1021
+#define AT_DATA_CRC_INITIAL_VALUE           0xFFFF
+#define AT_DATA_CRC_SIZE                    2
+#endif
+
+#ifdef AT_INCREMENTAL_PARSING
+#define AT_PARSE_NO_SLOT                    AT_COMMAND_LIST_SIZE
+#endif
+
+#if defined(__GNUC__)
+#define AT_MEMORY_BARRIER()                 __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define AT_COMPARE_AND_SWAP(ptr, expected, desired) __atomic_compare_exchange_n(ptr, expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)
+#else
+#define AT_MEMORY_BARRIER()
+// Single producer only.
+#define AT_COMPARE_AND_SWAP(ptr, expected, desired) (((*(ptr)) = (desired)), 1)
+#endif
+
+#ifdef AT_MULTITHREAD
+#define AT_THREAD_LOCAL                     _Thread_local
+#else
+#define AT_THREAD_LOCAL
+#endif
+
+#if ((AT_RX_LINES_NUMBER == 0) || ((AT_RX_LINES_NUMBER & (AT_RX_LINES_NUMBER - 1)) != 0) || (AT_RX_LINES_NUMBER > 128))
+#error "AT_RX_LINES_NUMBER must be a power of 2 lower or equal to 128"
+#endif
+#if ((AT_BUFFER_SIZE < 8) || (AT_BUFFER_SIZE > 0xFFFF))
+#error "AT_BUFFER_SIZE must be between 8 and 65535"
+#endif
+#if ((AT_TX_BUFFER_SIZE == 0) || (AT_TX_BUFFER_SIZE > 0xFFFF))
+#error "AT_TX_BUFFER_SIZE must be between 1 and 65535"
+#endif
+#if ((AT_COMMAND_LIST_SIZE < 4) || (AT_COMMAND_LIST_SIZE > 0xFFFE))
+#error "AT_COMMAND_LIST_SIZE must be between 4 and 65534"
+#endif
+#if ((AT_COMMAND_PARAMETER_MAX_NUMBER == 0) || (AT_HELP_LINES_PER_PROCESS == 0))
+#error "AT_COMMAND_PARAMETER_MAX_NUMBER and AT_HELP_LINES_PER_PROCESS must not be null"
+#endif
+#if (defined(AT_WORKER) && !defined(AT_MULTITHREAD))
+#error "AT_WORKER requires AT_MULTITHREAD"
+#endif
+#if (defined(AT_NO_HELP) && defined(AT_HELP_COMPRESSED))
+#error "AT_NO_HELP and AT_HELP_COMPRESSED are exclusive"
+#endif
+#ifdef AT_URC
+#if ((AT_URC_NUMBER == 0) || ((AT_URC_NUMBER & (AT_URC_NUMBER - 1)) != 0) || (AT_URC_NUMBER > 128))
+#error "AT_URC_NUMBER must be a power of 2 lower or equal to 128"
+#endif
+#if (AT_URC_SIZE < 2)
+#error "AT_URC_SIZE must be greater than 1"
+#endif
+#endif
+#ifdef AT_READ_CACHE
+#if ((AT_READ_CACHE_NUMBER == 0) || (AT_READ_CACHE_NUMBER > 0xFF))
+#error "AT_READ_CACHE_NUMBER must be between 1 and 255"
+#endif
+#if ((AT_READ_CACHE_SIZE == 0) || (AT_READ_CACHE_SIZE > 0xFFFF))
+#error "AT_READ_CACHE_SIZE must be between 1 and 65535"
+#endif
+#endif
+
 /*** AT local structures ***/
 
 /*******************************************************************/
-typedef union {
-    struct {
-        uint8_t process :1;
-        uint8_t pending :1;
-        uint8_t quiet :1;
-        uint8_t verbose :1;
-        uint8_t echo :1;
-    } field;
-    uint8_t all;
-} AT_flags_t;
+typedef AT_handle_t AT_context_t;
 
 /*******************************************************************/
 typedef struct {
-    AT_process_cb_t process_callback;
-    volatile AT_flags_t flags;
-    char rx_buffer[AT_BUFFER_SIZE];
-    uint8_t rx_buffer_size;
-    const AT_command_t *current_command;
-    const AT_command_t *commands_list[AT_COMMAND_LIST_SIZE];
-    uint8_t commands_count[AT_COMMAND_TYPE_LAST];
-} AT_context_t;
+    char *data;
+    uint32_t size;
+} AT_argument_slice_t;
+
+/*******************************************************************/
+typedef enum {
+    AT_PENDING_STATE_IDLE = 0,
+    AT_PENDING_STATE_WAITING,
+    AT_PENDING_STATE_COMPLETE,
+    AT_PENDING_STATE_TX // Next command executed once the TX buffer is empty (AT_ASYNCHRONOUS_TX only).
+} AT_pending_state_t;
+
+/*******************************************************************/
+typedef enum {
+    AT_TX_UNIT_NONE = 0,
+    AT_TX_UNIT_URC,
+    AT_TX_UNIT_ECHO,
+    AT_TX_UNIT_STATUS,
+    AT_TX_UNIT_HELP,
+    AT_TX_UNIT_JOB,
+    AT_TX_UNIT_DATA,
+    AT_TX_UNIT_COMMAND // Output of the built-in commands and of the command help.
+} AT_tx_unit_t;
+
+#ifdef AT_WORKER
+/*******************************************************************/
+typedef enum {
+    AT_JOB_STATE_UNKNOWN = 0, // Line not classified yet.
+    AT_JOB_STATE_INLINE,      // Line processed by AT_process() when it is the oldest one.
+    AT_JOB_STATE_WAITING,     // Job waiting for its resource.
+    AT_JOB_STATE_QUEUED,      // Job waiting for a worker.
+    AT_JOB_STATE_RUNNING,     // Job executed by a worker.
+    AT_JOB_STATE_DONE         // Job replies and status waiting to be printed.
+} AT_job_state_t;
+#endif
+
+#ifdef AT_INCREMENTAL_PARSING
+/*******************************************************************/
+typedef enum {
+    AT_PARSE_STATE_HEADER = 0, // Checking "AT" header and type marker.
+    AT_PARSE_STATE_SYNTAX,     // Narrowing the index range of the type, the longest matching command is stored.
+    AT_PARSE_STATE_MATCH,      // No more candidate, the longest matching command (if any) is known.
+    AT_PARSE_STATE_OTHER,      // Not a command or index updated: the line is parsed by AT_process().
+    AT_PARSE_STATE_REJECTED    // Invalid header, the end of the line is not stored.
+} AT_parse_state_t;
+#endif
+
+#ifdef AT_DATA_MODE
+/*******************************************************************/
+typedef enum {
+    AT_DATA_STATE_IDLE = 0,
+    AT_DATA_STATE_RECEIVING,
+    AT_DATA_STATE_COMPLETE
+} AT_data_state_t;
+#endif
+
+#ifndef AT_NO_HELP
+/*******************************************************************/
+typedef enum {
+    AT_HELP_LINE_TYPE = 0,
+    AT_HELP_LINE_COMMAND,
+    AT_HELP_LINE_EXECUTION,
+    AT_HELP_LINE_WRITE,
+    AT_HELP_LINE_READ,
+    AT_HELP_LINE_LAST
+} AT_help_line_t;
+#endif
 
 /*** AT local functions declaration ***/
 
@@ -99,6 +222,26 @@ AT_status_t _verbose_write_callback(uint32_t argc, char *argv[], int32_t *error_
 AT_status_t _quiet_execution_callback(int32_t *error_code);
 AT_status_t _quiet_write_callback(uint32_t argc, char *argv[], int32_t *error_code);
 
+#ifdef AT_STATISTICS
+AT_status_t _statistics_execution_callback(int32_t *error_code);
+#endif
+
+#ifdef AT_METRICS
+AT_status_t _metrics_execution_callback(int32_t *error_code);
+#endif
+
+#ifndef AT_NO_HELP
+static AT_status_t _print_command_help(AT_context_t *ctx, const AT_command_t *command);
+#endif
+static uint32_t _get_index_offset(AT_context_t *ctx, AT_command_type_t type);
+
+static AT_status_t _default_hw_init(void *hw_context, AT_HW_API_ex_config_t *hw_api_config);
+static AT_status_t _default_hw_de_init(void *hw_context);
+static AT_status_t _default_hw_write(void *hw_context, uint8_t *data, uint32_t data_size_bytes);
+#ifdef AT_ASYNCHRONOUS_TX
+static AT_status_t _default_hw_write_async(void *hw_context, uint8_t *data, uint32_t data_size_bytes);
+#endif
+
 /*** AT local global variables ***/
 
 static const char AT_COMMAND_HEADER[AT_COMMAND_TYPE_LAST] = {
@@ -107,807 +250,4308 @@ static const char AT_COMMAND_HEADER[AT_COMMAND_TYPE_LAST] = {
     AT_COMMAND_HEADER_DEBUG,
 };
 
+#ifndef AT_NO_HELP
+static const char *const AT_HELP_TYPE_TITLE[AT_COMMAND_TYPE_LAST] = {
+    "Basic commands",
+    "Extended commands",
+    "Debug commands",
+};
+#endif
+
 static const AT_command_t AT_COMMAND_ECHO = {
     .syntax = "E",
     .type = AT_COMMAND_TYPE_BASIC,
-    .help = "Interface echo control",
+    .help = AT_HELP("Interface echo control"),
     .execution_callback = &_echo_execution_callback,
-    .execution_help = "Disable echo",
+    .execution_help = AT_HELP("Disable echo"),
     .read_callback = NULL,
     .read_help = NULL,
     .write_callback = &_echo_write_callback,
-    .write_arguments = "<enable>",
-    .write_help = "Enable (1) or disable (0) echo",
+    .write_arguments = AT_HELP("<enable>"),
+    .write_help = AT_HELP("Enable (1) or disable (0) echo"),
 };
 
 static const AT_command_t AT_COMMAND_VERBOSE = {
     .syntax = "V",
     .type = AT_COMMAND_TYPE_BASIC,
-    .help = "Interface verbosity level",
+    .help = AT_HELP("Interface verbosity level"),
     .execution_callback = &_verbose_execution_callback,
-    .execution_help = "Disable verbose mode",
+    .execution_help = AT_HELP("Disable verbose mode"),
     .read_callback = NULL,
     .read_help = NULL,
     .write_callback = &_verbose_write_callback,
-    .write_arguments = "<enable>",
-    .write_help = "Enable (1) or disable (0) verbose mode",
+    .write_arguments = AT_HELP("<enable>"),
+    .write_help = AT_HELP("Enable (1) or disable (0) verbose mode"),
 };
 
 static const AT_command_t AT_COMMAND_QUIET = {
     .syntax = "Q",
     .type = AT_COMMAND_TYPE_BASIC,
-    .help = "Interface quiet mode control",
+    .help = AT_HELP("Interface quiet mode control"),
     .execution_callback = &_quiet_execution_callback,
-    .execution_help = "Disable quiet mode",
+    .execution_help = AT_HELP("Disable quiet mode"),
     .read_callback = NULL,
     .read_help = NULL,
     .write_callback = &_quiet_write_callback,
-    .write_arguments = "<enable>",
-    .write_help = "Enable (1) or disable (0) quiet mode",
+    .write_arguments = AT_HELP("<enable>"),
+    .write_help = AT_HELP("Enable (1) or disable (0) quiet mode"),
+};
+
+#ifdef AT_STATISTICS
+static const AT_command_t AT_COMMAND_STATISTICS = {
+    .syntax = "STATS",
+    .type = AT_COMMAND_TYPE_DEBUG,
+    .help = AT_HELP("Commands processing timings"),
+    .execution_callback = &_statistics_execution_callback,
+    .execution_help = AT_HELP("Print count and min/avg/max latency, lookup, callback and print timings of each executed command"),
+    .read_callback = NULL,
+    .read_help = NULL,
+    .write_callback = NULL,
+    .write_arguments = NULL,
+    .write_help = NULL,
+};
+#endif
+
+#ifdef AT_METRICS
+static const AT_command_t AT_COMMAND_METRICS = {
+    .syntax = "METRICS",
+    .type = AT_COMMAND_TYPE_DEBUG,
+    .help = AT_HELP("Traffic counters"),
+    .execution_callback = &_metrics_execution_callback,
+    .execution_help = AT_HELP("Print RX, TX, non null status and executed command counters"),
+    .read_callback = NULL,
+    .read_help = NULL,
+    .write_callback = NULL,
+    .write_arguments = NULL,
+    .write_help = NULL,
+};
+#endif
+
+// Built-in commands, sorted by type then by syntax.
+static const AT_command_t *const AT_BUILTIN_COMMANDS[] = {
+    &AT_COMMAND_ECHO,
+    &AT_COMMAND_QUIET,
+    &AT_COMMAND_VERBOSE,
+#ifdef AT_METRICS
+    &AT_COMMAND_METRICS,
+#endif
+#ifdef AT_STATISTICS
+    &AT_COMMAND_STATISTICS,
+#endif
+};
+
+static const AT_HW_API_ops_t AT_HW_API_DEFAULT_OPS = {
+    .init = &_default_hw_init,
+    .de_init = &_default_hw_de_init,
+    .write = &_default_hw_write,
+#ifdef AT_ASYNCHRONOUS_TX
+    .write_async = &_default_hw_write_async,
+#endif
+};
+
+// Verbose status strings indexed by status code (driver errors have no string).
+static const char *const AT_STATUS_STRING[AT_ERROR_LAST] = {
+    [AT_SUCCESS] = "OK",
+    [AT_ERROR_INTERNAL_COMMAND_PARSING] = "ERROR:COMMAND_PARSING",
+    [AT_ERROR_INTERNAL_COMMAND_NOT_FOUND] = "ERROR:COMMAND_NOT_FOUND",
+    [AT_ERROR_INTERNAL_COMMAND_MARKER_NOT_DEFINED] = "ERROR:COMMAND_MARKER_NOT_DEFINED",
+    [AT_ERROR_INTERNAL_COMMAND_EXECUTION_NOT_DEFINED] = "ERROR:COMMAND_EXECUTION_NOT_DEFINED",
+    [AT_ERROR_INTERNAL_COMMAND_WRITE_NOT_DEFINED] = "ERROR:COMMAND_WRITE_NOT_DEFINED",
+    [AT_ERROR_INTERNAL_COMMAND_READ_NOT_DEFINED] = "ERROR:COMMAND_READ_NOT_DEFINED",
+    [AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_NUMBER] = "ERROR:COMMAND_BAD_PARAMETER_NUMBER:",
+    [AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_PARSING] = "ERROR:COMMAND_BAD_PARAMETER_PARSING:",
+    [AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_VALUE] = "ERROR:COMMAND_BAD_PARAMETER_VALUE:",
+    [AT_ERROR_EXTERNAL_COMMAND_CORE_ERROR] = "ERROR:COMMAND_CORE_ERROR:",
+    [AT_ERROR_INTERNAL_DATA_CRC] = "ERROR:DATA_CRC",
+    [AT_ERROR_INTERNAL_DATA_TIMEOUT] = "ERROR:DATA_TIMEOUT",
+};
+
+static const char AT_HEX_DIGITS[16] = {
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+};
+
+// Value of each hexadecimal character, 0xFF for invalid characters.
+static const uint8_t AT_HEX_VALUES[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
 };
 
+// Default instance.
 static AT_context_t at_ctx = {
+    .hw_ops = &AT_HW_API_DEFAULT_OPS,
+    .hw_context = NULL,
     .process_callback = NULL,
+#ifdef AT_WORKER
+    .worker_callback = NULL,
+#endif
     .flags.all = 0,
-    .rx_buffer = {0x00},
-    .rx_buffer_size = 0,
+    .rx_lines = {{{0x00}, 0, 0}},
+    .rx_write_count = 0,
+    .rx_read_count = 0,
+    .rx_drop_flag = 0,
+    .rx_dropped_lines_count = 0,
+    .rx_partial_flag = 0,
+    .rx_timestamp = 0,
+    .rx_timeout = 0,
+#ifdef AT_URC
+    .urc = {{{0x00}, 0}},
+    .urc_write_count = 0,
+    .urc_read_count = 0,
+#endif
+#ifdef AT_READ_CACHE
+    .read_cache = {{NULL, 0, 0, 0, {0x00}}},
+    .read_cache_capture = NULL,
+    .read_cache_overflow = 0,
+    .read_cache_capture_generation = 0,
+    .read_cache_generation = 0,
+#endif
+    .tx_buffer = {0x00},
+#ifdef AT_ASYNCHRONOUS_TX
+    .tx_write_index = 0,
+    .tx_read_index = 0,
+    .tx_busy_size = 0,
+    .tx_wrap_index = AT_TX_BUFFER_SIZE,
+    .tx_wait_flag = 0,
+    .tx_unit = AT_TX_UNIT_NONE,
+    .tx_suspended_flag = 0,
+    .tx_unit_size = 0,
+    .tx_skip_size = 0,
+    .tx_reply_size = 0,
+#else
+    .tx_buffer_size = 0,
+#endif
+    .reply_area = NULL,
+    .reply_reserved_size = 0,
     .current_command = NULL,
     .commands_list = {NULL},
     .commands_count = {0},
+    .commands_index = {0},
+    .commands_syntax_size = {0},
+    .commands_free = 0,
+#if defined(AT_STATISTICS) || defined(AT_METRICS)
+    .commands_tables = {{NULL, {0}, 0}},
+    .commands_tables_count = 0,
+    .tables_slots_count = 0,
+#else
+    .commands_tables = {{NULL, {0}}},
+    .commands_tables_count = 0,
+#endif
+#ifndef AT_NO_HELP
+    .help_flag = 0,
+    .help_type = 0,
+    .help_table = 0,
+    .help_slot = 0,
+    .help_line = 0,
+#endif
+    .get_timestamp_callback = NULL,
+    .line_status = AT_SUCCESS,
+    .line_error_code = 0,
+    .line_error_command = NULL,
+    .pending_state = AT_PENDING_STATE_IDLE,
+    .pending_command = NULL,
+    .pending_next_command = NULL,
+    .pending_status = AT_SUCCESS,
+    .pending_error_code = 0,
+#ifdef AT_DATA_MODE
+    .data_config = {0, 0, NULL, NULL},
+    .data_state = 0,
+    .data_crc_size = 0,
+    .data_crc = 0,
+    .data_received_crc = 0,
+    .data_remaining_size = 0,
+    .data_timestamp = 0,
+#endif
+#ifdef AT_STATISTICS
+    .statistics_slot = AT_STATISTICS_NO_SLOT,
+    .statistics_timings = {0},
+    .commands_statistics = {{0}},
+#endif
+#ifdef AT_METRICS
+    .metrics = {0},
+#ifdef AT_ASYNCHRONOUS_TX
+    .metrics_snapshot = {0},
+#endif
+#endif
 };
 
+// Instance executing a command in the current thread.
+static AT_THREAD_LOCAL AT_context_t *at_current_ctx = NULL;
+#ifdef AT_WORKER
+// Job executed by a worker in the current thread.
+static AT_THREAD_LOCAL AT_rx_line_t *at_current_job = NULL;
+// Worker commands of the same resource are serialized.
+#define AT_WORKER_RESOURCE_MASK(command)    (1UL << ((command)->resource & 0x1F))
+#endif
+
 /*** AT local functions ***/
 
 /*******************************************************************/
-static void _rx_irq_callback(uint8_t data) {
-    // Ignore null data and if processing pending.
-    if (data == 0x00 || at_ctx.flags.field.pending == 1) {
+static AT_context_t *_get_current_context(void) {
+    // Use default instance outside of command execution.
+    return (at_current_ctx != NULL) ? at_current_ctx : &at_ctx;
+}
+
+/*******************************************************************/
+static uint32_t _get_timestamp(AT_context_t *ctx) {
+    return (ctx->get_timestamp_callback != NULL) ? ctx->get_timestamp_callback() : 0;
+}
+
+#ifdef AT_STATISTICS
+/*******************************************************************/
+static void _statistics_update(AT_context_t *ctx) {
+    // Local variables.
+    AT_statistics_t *statistics = NULL;
+    uint32_t phase = 0;
+    uint32_t timing = 0;
+    // Check if a command has been found.
+    if (ctx->statistics_slot >= AT_STATISTICS_NO_SLOT) {
         goto errors;
     }
-    // Check end marker.
-    if (data == AT_COMMAND_MARKER_END) {
-        // Set flag.
-        at_ctx.flags.field.process = 1;
-        at_ctx.flags.field.pending = 1;
-        // Ask for processing.
-        if (at_ctx.process_callback != NULL) {
-            at_ctx.process_callback();
+    statistics = &ctx->commands_statistics[ctx->statistics_slot];
+    for (phase = 0; phase < AT_STATISTICS_PHASE_LAST; phase++) {
+        timing = ctx->statistics_timings[phase];
+        if ((statistics->count == 0) || (timing < statistics->min[phase])) {
+            statistics->min[phase] = timing;
         }
-    } else {
-        // Store new byte in buffer.
-        at_ctx.rx_buffer[at_ctx.rx_buffer_size] = (char) data;
-        at_ctx.rx_buffer_size = (at_ctx.rx_buffer_size + 1) % AT_BUFFER_SIZE;
+        if (timing > statistics->max[phase]) {
+            statistics->max[phase] = timing;
+        }
+        statistics->sum[phase] += timing;
     }
+    statistics->count++;
 errors:
-    return;
+    ctx->statistics_slot = AT_STATISTICS_NO_SLOT;
 }
+#endif
 
+#ifdef AT_METRICS
 /*******************************************************************/
-AT_status_t _parse_bit(uint32_t argc, char *argv[], uint8_t *bit) {
+static void _metrics_hit(AT_context_t *ctx, uint32_t command_slot) {
+    // Commands of the constant tables are counted in the slots following the list.
+    ctx->metrics.command_hits[command_slot]++;
+}
+#endif
+
+/*******************************************************************/
+static AT_rx_line_t *_rx_get_line(AT_context_t *ctx) {
+    // Check if all lines are waiting for processing.
+    if (((uint8_t) (ctx->rx_write_count - ctx->rx_read_count)) >= AT_RX_LINES_NUMBER) {
+        // Drop the whole incoming line, even if a line is released before its end.
+        ctx->rx_drop_flag = 1;
+    }
+    return (ctx->rx_drop_flag == 0) ? &ctx->rx_lines[ctx->rx_write_count % AT_RX_LINES_NUMBER] : NULL;
+}
+
+/*******************************************************************/
+static void _rx_release_line(AT_context_t *ctx, AT_rx_line_t *line) {
+    // Reset line state only: the buffer content is terminated by the RX interrupt at the end of the next line.
+    line->size = 0;
+    line->overflow = 0;
+#ifdef AT_INCREMENTAL_PARSING
+    line->parse_state = AT_PARSE_STATE_HEADER;
+#endif
+#ifdef AT_WORKER
+    line->job_state = AT_JOB_STATE_UNKNOWN;
+    line->job_reply_size = 0;
+    line->job_reply_flag = 0;
+#endif
+    // Release line.
+    AT_MEMORY_BARRIER();
+    ctx->rx_read_count++;
+}
+
+/*******************************************************************/
+static void _rx_check_timeout(AT_context_t *ctx) {
     // Local variables.
-    AT_status_t status = AT_SUCCESS;
-    int tmp_int = 0;
-    // Check number of arguments.
-    if (argc != 1) {
-        status = AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_NUMBER;
+    AT_rx_line_t *line = NULL;
+    uint32_t timestamp = 0;
+    // Check if the timeout is enabled.
+    if (ctx->rx_timeout == 0) {
         goto errors;
     }
-    // Parse parameter.
-    if (sscanf((argv[0]), "%d", &tmp_int) != 1) {
-        status = AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_PARSING;
-        goto errors;
+    timestamp = _get_timestamp(ctx);
+    // Discard the partial line received before the timeout.
+    if ((ctx->rx_partial_flag != 0) && ((uint32_t) (timestamp - ctx->rx_timestamp) > ctx->rx_timeout)) {
+        if (ctx->rx_drop_flag != 0) {
+            ctx->rx_dropped_lines_count++;
+            ctx->rx_drop_flag = 0;
+        } else {
+            line = &ctx->rx_lines[ctx->rx_write_count % AT_RX_LINES_NUMBER];
+            line->size = 0;
+            line->overflow = 0;
+#ifdef AT_INCREMENTAL_PARSING
+            line->parse_state = AT_PARSE_STATE_HEADER;
+#endif
+        }
+        ctx->rx_partial_flag = 0;
     }
-    if (tmp_int > 1) {
-        status = AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_VALUE;
+    ctx->rx_timestamp = timestamp;
+errors:
+    return;
+}
+
+/*******************************************************************/
+static void _rx_end_line(AT_context_t *ctx) {
+    // Local variables.
+    AT_rx_line_t *line = NULL;
+    ctx->rx_partial_flag = 0;
+    // Check drop flag.
+    if (ctx->rx_drop_flag != 0) {
+        ctx->rx_dropped_lines_count++;
+        ctx->rx_drop_flag = 0;
         goto errors;
     }
-    (*bit) = (uint8_t) tmp_int;
-    return AT_SUCCESS;
+    // Terminate line (size is always lower than the buffer size).
+    line = &ctx->rx_lines[ctx->rx_write_count % AT_RX_LINES_NUMBER];
+    line->buffer[line->size] = '\0';
+#ifdef AT_STATISTICS
+    line->timestamp = _get_timestamp(ctx);
+#endif
+#ifdef AT_METRICS
+    ctx->metrics.rx_lines++;
+#endif
+    // Commit line.
+    AT_MEMORY_BARRIER();
+    ctx->rx_write_count++;
+    // Ask for processing.
+    if (ctx->process_callback != NULL) {
+        ctx->process_callback();
+    }
 errors:
-    return status;
+    return;
 }
 
+#ifdef AT_DATA_MODE
 /*******************************************************************/
-AT_status_t _echo_execution_callback(int32_t *error_code) {
+static uint16_t _compute_crc(uint16_t crc, const uint8_t *data, uint32_t size) {
     // Local variables.
-    AT_status_t status = AT_SUCCESS;
-    // Reset error code.
-    (*error_code) = 0;
-    // Disable echo.
-    at_ctx.flags.field.echo = 0;
-    return status;
+    uint32_t idx = 0;
+    uint8_t bit = 0;
+    // CRC-16/CCITT, MSB first.
+    for (idx = 0; idx < size; idx++) {
+        crc ^= (uint16_t) (data[idx] << 8);
+        for (bit = 0; bit < 8; bit++) {
+            crc = ((crc & 0x8000) != 0) ? (uint16_t) ((crc << 1) ^ AT_DATA_CRC_POLYNOMIAL) : (uint16_t) (crc << 1);
+        }
+    }
+    return crc;
 }
 
 /*******************************************************************/
-AT_status_t _echo_write_callback(uint32_t argc, char *argv[], int32_t *error_code) {
+static uint32_t _rx_data(AT_context_t *ctx, const uint8_t *data, uint32_t size) {
     // Local variables.
-    AT_status_t status = AT_SUCCESS;
-    uint8_t enable = 0;
-    // Reset error code.
-    (*error_code) = 0;
-    // Check number of arguments.
-    status = _parse_bit(argc, argv, &enable);
-    if (status != AT_SUCCESS) {
+    uint32_t payload_size = (size < ctx->data_remaining_size) ? size : ctx->data_remaining_size;
+    uint32_t consumed_size = payload_size;
+    // Give payload to the user sink.
+    if (payload_size > 0) {
+        ctx->data_crc = _compute_crc(ctx->data_crc, data, payload_size);
+        ctx->data_config.data_callback(data, payload_size);
+        ctx->data_remaining_size -= payload_size;
+    }
+    // Read CRC.
+    while ((consumed_size < size) && (ctx->data_crc_size < AT_DATA_CRC_SIZE)) {
+        ctx->data_received_crc = (uint16_t) ((ctx->data_received_crc << 8) | data[consumed_size]);
+        ctx->data_crc_size++;
+        consumed_size++;
+    }
+    ctx->data_timestamp = _get_timestamp(ctx);
+    // Check end of frame: next bytes are text lines again.
+    if (ctx->data_crc_size >= AT_DATA_CRC_SIZE) {
+        ctx->data_state = AT_DATA_STATE_COMPLETE;
+        if (ctx->process_callback != NULL) {
+            ctx->process_callback();
+        }
+    }
+    return consumed_size;
+}
+
+#endif
+
+#ifdef AT_INCREMENTAL_PARSING
+/*******************************************************************/
+static uint32_t _get_character_bound(AT_context_t *ctx, uint32_t low, uint32_t high, uint32_t offset, uint8_t character, uint8_t strict_flag) {
+    // Local variables.
+    uint32_t middle = 0;
+    uint8_t syntax_character = 0;
+    // Search first index whose character at offset is greater or equal (strictly greater) than the given one.
+    while (low < high) {
+        middle = low + ((high - low) / 2);
+        syntax_character = (uint8_t) ctx->commands_list[ctx->commands_index[middle]]->syntax[offset];
+        if ((syntax_character < character) || ((strict_flag != 0) && (syntax_character == character))) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+/*******************************************************************/
+static void _rx_parse_syntax(AT_context_t *ctx, AT_rx_line_t *line, uint8_t data) {
+    // Local variables.
+    uint32_t offset = (uint32_t) (line->size - line->parse_start);
+    uint32_t low = line->parse_low;
+    uint32_t high = line->parse_high;
+    // Check index update.
+    if (line->parse_generation != ctx->commands_generation) {
+        line->parse_state = AT_PARSE_STATE_OTHER;
         goto errors;
     }
-    // Update echo.
-    at_ctx.flags.field.echo = enable;
-    return AT_SUCCESS;
+    // Candidates share the first offset characters: skip the one already fully matched (shorter syntax is lower).
+    while ((low < high) && (ctx->commands_syntax_size[ctx->commands_index[low]] == offset)) {
+        low++;
+    }
+    // Keep candidates with the same character at offset.
+    low = _get_character_bound(ctx, low, high, offset, data, 0);
+    high = _get_character_bound(ctx, low, high, offset, data, 1);
+    if (low < high) {
+        // Check full syntax match.
+        if (ctx->commands_syntax_size[ctx->commands_index[low]] == (offset + 1)) {
+            line->parse_slot = ctx->commands_index[low];
+            line->parse_size = (AT_line_size_t) (offset + 1);
+        }
+        line->parse_low = (AT_command_index_t) low;
+        line->parse_high = (AT_command_index_t) high;
+    } else {
+        // The line is still stored since the next concatenated commands can be valid.
+        line->parse_state = AT_PARSE_STATE_MATCH;
+    }
 errors:
-    return status;
+    return;
 }
 
 /*******************************************************************/
-AT_status_t _verbose_execution_callback(int32_t *error_code) {
+static void _rx_parse_byte(AT_context_t *ctx, AT_rx_line_t *line, uint8_t data) {
     // Local variables.
-    AT_status_t status = AT_SUCCESS;
-    // Reset error code.
-    (*error_code) = 0;
-    // Disable verbose.
-    at_ctx.flags.field.verbose = 0;
-    return status;
+    AT_command_type_t type = AT_COMMAND_TYPE_BASIC;
+    uint32_t low = 0;
+    // Byte position is the current line size.
+    switch (line->parse_state) {
+    case AT_PARSE_STATE_HEADER:
+        // Check header.
+        if (line->size < (sizeof(AT_HEADER) - 1)) {
+            if ((line->size) == 0) {
+                line->parse_generation = ctx->commands_generation;
+            }
+            if (data != (uint8_t) AT_HEADER[line->size]) {
+                line->parse_state = AT_PARSE_STATE_REJECTED;
+                line->parse_status = AT_ERROR_INTERNAL_COMMAND_PARSING;
+            }
+            break;
+        }
+        // Check if index is being updated.
+        if (((line->parse_generation & 0x01) != 0) || (data == AT_COMMAND_MARKER_READ_HELP)) {
+            line->parse_state = AT_PARSE_STATE_OTHER;
+            break;
+        }
+        // Check type marker.
+        if (data == AT_COMMAND_HEADER_EXTENDED) {
+            type = AT_COMMAND_TYPE_EXTENDED;
+        } else if (data == AT_COMMAND_HEADER_DEBUG) {
+            type = AT_COMMAND_TYPE_DEBUG;
+        }
+        low = _get_index_offset(ctx, type);
+        line->parse_low = (AT_command_index_t) low;
+        line->parse_high = (AT_command_index_t) (low + ctx->commands_count[type]);
+        line->parse_slot = AT_PARSE_NO_SLOT;
+        line->parse_size = 0;
+        line->parse_state = AT_PARSE_STATE_SYNTAX;
+        // Basic syntax starts right after the header.
+        if (type == AT_COMMAND_TYPE_BASIC) {
+            line->parse_start = line->size;
+            _rx_parse_syntax(ctx, line, data);
+        } else {
+            line->parse_start = (AT_line_size_t) (line->size + 1);
+        }
+        break;
+    case AT_PARSE_STATE_SYNTAX:
+        _rx_parse_syntax(ctx, line, data);
+        break;
+    default:
+        break;
+    }
 }
+#endif
 
 /*******************************************************************/
-AT_status_t _verbose_write_callback(uint32_t argc, char *argv[], int32_t *error_code) {
+static void _rx_irq_callback(AT_context_t *ctx, uint8_t data) {
     // Local variables.
-    AT_status_t status = AT_SUCCESS;
-    uint8_t enable = 0;
-    // Reset error code.
-    (*error_code) = 0;
-    // Check number of arguments.
-    status = _parse_bit(argc, argv, &enable);
-    if (status != AT_SUCCESS) {
+    AT_rx_line_t *line = NULL;
+#ifdef AT_DATA_MODE
+    // Binary frame bypasses lines.
+    if (ctx->data_state == AT_DATA_STATE_RECEIVING) {
+        _rx_data(ctx, &data, 1);
         goto errors;
     }
-    // Update echo.
-    at_ctx.flags.field.verbose = enable;
-    return AT_SUCCESS;
+#endif
+    // Ignore null data.
+    if (data == 0x00) {
+        goto errors;
+    }
+    _rx_check_timeout(ctx);
+    line = _rx_get_line(ctx);
+    // Check end marker.
+    if (data == AT_COMMAND_MARKER_END) {
+        _rx_end_line(ctx);
+        goto errors;
+    }
+    ctx->rx_partial_flag = 1;
+    if (line != NULL) {
+#ifdef AT_INCREMENTAL_PARSING
+        // Advance command search and stop storing rejected lines.
+        _rx_parse_byte(ctx, line, data);
+        if (line->parse_state == AT_PARSE_STATE_REJECTED) {
+            goto errors;
+        }
+#endif
+        // Store new byte in buffer (last byte is kept for null terminating character).
+        if (line->size < (AT_BUFFER_SIZE - 1)) {
+            line->buffer[line->size] = (char) data;
+            line->size++;
+        } else {
+            line->overflow = 1;
+        }
+    }
 errors:
-    return status;
+    return;
 }
 
 /*******************************************************************/
-AT_status_t _quiet_execution_callback(int32_t *error_code) {
+static void _rx_block_callback(AT_context_t *ctx, const uint8_t *data, uint32_t size) {
     // Local variables.
-    AT_status_t status = AT_SUCCESS;
-    // Reset error code.
-    (*error_code) = 0;
-    // Disable verbose.
-    at_ctx.flags.field.quiet = 0;
-    return status;
+    AT_rx_line_t *line = NULL;
+    const uint8_t *end_marker = NULL;
+    uint32_t segment_size = 0;
+    uint32_t copy_size = 0;
+    // Check parameter.
+    if (data == NULL) {
+        goto errors;
+    }
+    while (size > 0) {
+#ifdef AT_DATA_MODE
+        // Binary frame bypasses lines.
+        if (ctx->data_state == AT_DATA_STATE_RECEIVING) {
+            segment_size = _rx_data(ctx, data, size);
+            data += segment_size;
+            size -= segment_size;
+            continue;
+        }
+#endif
+        _rx_check_timeout(ctx);
+        // Search end of line in the remaining data.
+        end_marker = (const uint8_t *) memchr(data, AT_COMMAND_MARKER_END, size);
+        segment_size = (end_marker == NULL) ? size : ((uint32_t) (end_marker - data));
+        if (segment_size > 0) {
+            ctx->rx_partial_flag = 1;
+        }
+        line = _rx_get_line(ctx);
+        if ((line != NULL) && (segment_size > 0)) {
+            // Copy the line part at once (last byte is kept for null terminating character).
+            copy_size = (AT_BUFFER_SIZE - 1) - line->size;
+            if (segment_size > copy_size) {
+                line->overflow = 1;
+            } else {
+                copy_size = segment_size;
+            }
+            memcpy(&line->buffer[line->size], data, copy_size);
+            line->size += copy_size;
+#ifdef AT_INCREMENTAL_PARSING
+            // Blocks are not parsed during reception.
+            if (line->parse_state != AT_PARSE_STATE_REJECTED) {
+                line->parse_state = AT_PARSE_STATE_OTHER;
+            }
+#endif
+        }
+        if (end_marker == NULL) {
+            break;
+        }
+        _rx_end_line(ctx);
+        // Skip end marker.
+        data += (segment_size + 1);
+        size -= (segment_size + 1);
+    }
+errors:
+    return;
 }
 
 /*******************************************************************/
-AT_status_t _quiet_write_callback(uint32_t argc, char *argv[], int32_t *error_code) {
+static uint8_t _get_digit(char character) {
+    // Convert hexadecimal character.
+    return AT_HEX_VALUES[(uint8_t) character];
+}
+
+/*******************************************************************/
+static AT_status_t _parse_unsigned(const char *data, uint32_t size, uint32_t *value) {
     // Local variables.
     AT_status_t status = AT_SUCCESS;
-    uint8_t enable = 0;
-    // Reset error code.
-    (*error_code) = 0;
-    // Check number of arguments.
-    status = _parse_bit(argc, argv, &enable);
-    if (status != AT_SUCCESS) {
+    uint32_t base = 10;
+    uint32_t digit = 0;
+    uint32_t idx = 0;
+    // Reset value.
+    (*value) = 0;
+    // Check empty argument.
+    if ((data == NULL) || (size == 0)) {
+        status = AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_PARSING;
         goto errors;
     }
-    // Update echo.
-    at_ctx.flags.field.quiet = enable;
-    return AT_SUCCESS;
+    // Check hexadecimal prefix.
+    if ((size > 2) && (data[0] == '0') && ((data[1] == 'x') || (data[1] == 'X'))) {
+        base = 16;
+        idx = 2;
+    }
+    for (; idx < size; idx++) {
+        digit = _get_digit(data[idx]);
+        if (digit >= base) {
+            status = AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_PARSING;
+            goto errors;
+        }
+        // Check overflow.
+        if ((*value) > ((UINT32_MAX - digit) / base)) {
+            status = AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_VALUE;
+            goto errors;
+        }
+        (*value) = ((*value) * base) + digit;
+    }
 errors:
     return status;
 }
 
 /*******************************************************************/
-static AT_status_t _print_tab(char *tab, uint32_t tab_size) {
+static AT_status_t _parse_signed(const char *data, uint32_t size, uint32_t max, int32_t *value) {
     // Local variables.
     AT_status_t status = AT_SUCCESS;
-    // Check quiet flag.
-    if ((at_ctx.flags.field.quiet != 0) || (tab_size == 0)) {
-        goto errors;
+    uint32_t magnitude = 0;
+    uint8_t negative = 0;
+    // Check sign.
+    if ((data != NULL) && (size > 0) && ((data[0] == '-') || (data[0] == '+'))) {
+        negative = (data[0] == '-') ? 1 : 0;
+        data++;
+        size--;
     }
-    // Write text.
-    status = AT_HW_API_write((uint8_t *) tab, tab_size);
+    status = _parse_unsigned(data, size, &magnitude);
     if (status != AT_SUCCESS) {
         goto errors;
     }
+    // Check range.
+    if (magnitude > (max + negative)) {
+        status = AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_VALUE;
+        goto errors;
+    }
+    (*value) = (negative != 0) ? ((int32_t) (0 - magnitude)) : ((int32_t) magnitude);
 errors:
     return status;
 }
 
 /*******************************************************************/
-static AT_status_t _print(const char *text) {
+static AT_status_t _decode_hex(const char *data, uint32_t size, uint8_t *output) {
     // Local variables.
     AT_status_t status = AT_SUCCESS;
-    // Write end marker.
-    status = _print_tab((char *) text, strlen(text));
+    const uint8_t *hex = (const uint8_t *) data;
+    uint8_t check = 0;
+    uint8_t high = 0;
+    uint8_t low = 0;
+    uint32_t idx = 0;
+    // Check size.
+    if ((size % 2) != 0) {
+        status = AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_PARSING;
+        goto errors;
+    }
+    // Invalid characters are accumulated and checked once at the end, to keep the loops branchless.
+    if (output == NULL) {
+        for (idx = 0; idx < size; idx++) {
+            check |= AT_HEX_VALUES[hex[idx]];
+        }
+    } else {
+        // Output may be the input itself since it is written 2 times slower than read.
+        for (idx = 0; idx < (size / 2); idx++) {
+            high = AT_HEX_VALUES[hex[2 * idx]];
+            low = AT_HEX_VALUES[hex[(2 * idx) + 1]];
+            check |= (uint8_t) (high | low);
+            output[idx] = (uint8_t) ((high << 4) | (low & 0x0F));
+        }
+    }
+    if ((check & 0xF0) != 0) {
+        status = AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_PARSING;
+        goto errors;
+    }
+errors:
     return status;
 }
 
 /*******************************************************************/
-static AT_status_t _end_line(void) {
+static void _encode_hex(const uint8_t *data, uint32_t size, char *hex) {
     // Local variables.
-    AT_status_t status = AT_SUCCESS;
-    // Write end marker.
-    status = _print_tab(AT_REPLY_END, 2);
-    return status;
+    uint32_t idx = 0;
+    // Two characters per byte, most significant nibble first.
+    for (idx = 0; idx < size; idx++) {
+        hex[2 * idx] = AT_HEX_DIGITS[data[idx] >> 4];
+        hex[(2 * idx) + 1] = AT_HEX_DIGITS[data[idx] & 0x0F];
+    }
 }
 
 /*******************************************************************/
-static AT_status_t _print_line(const char *line) {
+static AT_status_t _get_schema_item(const char **schema, AT_argument_type_t *type, uint32_t *limit) {
     // Local variables.
     AT_status_t status = AT_SUCCESS;
-    // Write text.
-    status = _print(line);
-    if (status != AT_SUCCESS) {
+    const char *item = (*schema);
+    uint32_t item_size = 0;
+    uint32_t bits = 0;
+    // Search end of item.
+    while ((item[item_size] != AT_COMMAND_PARAMETER_SEPARATOR) && (item[item_size] != '\0')) {
+        item_size++;
+    }
+    (*schema) = (item[item_size] == AT_COMMAND_PARAMETER_SEPARATOR) ? &item[item_size + 1] : &item[item_size];
+    (*limit) = 0;
+    // Buffer types, with optional size.
+    if ((item_size >= 3) && ((memcmp(item, "hex", 3) == 0) || (memcmp(item, "str", 3) == 0))) {
+        (*type) = (item[0] == 'h') ? AT_ARGUMENT_TYPE_HEX : AT_ARGUMENT_TYPE_STRING;
+        if ((item_size > 3) && (_parse_unsigned(&item[3], (item_size - 3), limit) != AT_SUCCESS)) {
+            status = AT_ERROR_COMMAND_SCHEMA;
+        }
         goto errors;
     }
-    // Write end marker.
-    status = _end_line();
+    // Integer types.
+    if ((item_size < 2) || ((item[0] != 'u') && (item[0] != 'i')) || (_parse_unsigned(&item[1], (item_size - 1), &bits) != AT_SUCCESS)) {
+        status = AT_ERROR_COMMAND_SCHEMA;
+        goto errors;
+    }
+    if ((bits != 8) && (bits != 16) && (bits != 32)) {
+        status = AT_ERROR_COMMAND_SCHEMA;
+        goto errors;
+    }
+    (*type) = (item[0] == 'u') ? AT_ARGUMENT_TYPE_UNSIGNED : AT_ARGUMENT_TYPE_SIGNED;
+    // Limit is the maximum positive value.
+    (*limit) = (uint32_t) (UINT32_MAX >> ((32 - bits) + (((*type) == AT_ARGUMENT_TYPE_SIGNED) ? 1 : 0)));
 errors:
     return status;
 }
 
 /*******************************************************************/
-static void _print_command_status(AT_status_t at_status, int32_t error_code) {
+static uint32_t _get_schema_size(const char *schema) {
     // Local variables.
-    uint32_t reply_size = 0;
-    char tx_buffer[AT_BUFFER_SIZE] = {0x00};
-    // Check verbose flag.
-    if (at_ctx.flags.field.verbose == 0) {
-        // Print status as numerical value.
-        reply_size = snprintf(tx_buffer, AT_BUFFER_SIZE, "%d", at_status);
-    } else {
-        // Print header.
-        if (at_status == AT_SUCCESS) {
-            _print("OK");
-        } else {
-            _print("ERROR:");
-            switch (at_status) {
-            case AT_ERROR_INTERNAL_COMMAND_PARSING:
-                reply_size = snprintf(tx_buffer, AT_BUFFER_SIZE, "COMMAND_PARSING");
-                break;
-            case AT_ERROR_INTERNAL_COMMAND_NOT_FOUND:
-                reply_size = snprintf(tx_buffer, AT_BUFFER_SIZE, "COMMAND_NOT_FOUND");
-                break;
-            case AT_ERROR_INTERNAL_COMMAND_MARKER_NOT_DEFINED:
-                reply_size = snprintf(tx_buffer, AT_BUFFER_SIZE, "COMMAND_MARKER_NOT_DEFINED");
-                break;
-            case AT_ERROR_INTERNAL_COMMAND_EXECUTION_NOT_DEFINED:
-                reply_size = snprintf(tx_buffer, AT_BUFFER_SIZE, "COMMAND_EXECUTION_NOT_DEFINED");
-                break;
-            case AT_ERROR_INTERNAL_COMMAND_WRITE_NOT_DEFINED:
-                reply_size = snprintf(tx_buffer, AT_BUFFER_SIZE, "COMMAND_WRITE_NOT_DEFINED");
-                break;
-            case AT_ERROR_INTERNAL_COMMAND_READ_NOT_DEFINED:
-                reply_size = snprintf(tx_buffer, AT_BUFFER_SIZE, "COMMAND_READ_NOT_DEFINED");
-                break;
-            case AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_NUMBER:
-                reply_size = snprintf(tx_buffer, AT_BUFFER_SIZE, "COMMAND_BAD_PARAMETER_NUMBER:%ld", error_code);
-                break;
-            case AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_PARSING:
-                reply_size = snprintf(tx_buffer, AT_BUFFER_SIZE, "COMMAND_BAD_PARAMETER_PARSING:%ld", error_code);
-                break;
-            case AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_VALUE:
-                reply_size = snprintf(tx_buffer, AT_BUFFER_SIZE, "COMMAND_BAD_PARAMETER_VALUE:%ld", error_code);
-                break;
-            case AT_ERROR_EXTERNAL_COMMAND_CORE_ERROR:
-                if (at_ctx.current_command->enum_to_str_callback != NULL) {
-                    reply_size = snprintf(tx_buffer, AT_BUFFER_SIZE, "COMMAND_CORE_ERROR:%s", at_ctx.current_command->enum_to_str_callback(error_code));
-                } else {
-                    reply_size = snprintf(tx_buffer, AT_BUFFER_SIZE, "COMMAND_CORE_ERROR:0x%02X", (unsigned int) error_code);
-                }
-                break;
-            default:
-                reply_size = snprintf(tx_buffer, AT_BUFFER_SIZE, "UNKNOWN:%d", at_status);
-                break;
-            }
-        }
+    uint32_t count = (schema[0] == '\0') ? 0 : 1;
+    // Count items.
+    while ((*schema) != '\0') {
+        count += ((*schema) == AT_COMMAND_PARAMETER_SEPARATOR) ? 1 : 0;
+        schema++;
     }
-    _print_tab(tx_buffer, reply_size);
-    _end_line();
+    return count;
 }
 
 /*******************************************************************/
-static AT_status_t _parse_and_execute_command(char *input_command, AT_command_type_t type, int32_t *command_return_code) {
+static AT_status_t _check_schema(const char *schema) {
     // Local variables.
     AT_status_t status = AT_SUCCESS;
-    uint32_t command_size = 0;
-    char *content = input_command;
-    char *parameter;
-    const char *separators = ",\0";
-    char *command_argv[AT_COMMAND_PARAMETER_MAX_NUMBER] = {NULL};
-    uint32_t command_argc = 0;
-    uint32_t idx = 0;
-    // Reset current command.
-    at_ctx.current_command = NULL;
-    // Search command in list.
-    for (idx = 0; idx < AT_COMMAND_LIST_SIZE; idx++) {
-        // Check existence.
-        if (at_ctx.commands_list[idx] == NULL) {
-            continue;
-        }
-        // Check type.
-        if ((at_ctx.commands_list[idx]->type) != type) {
-            continue;
-        }
-        // Check syntax.
-        command_size = strlen(at_ctx.commands_list[idx]->syntax);
-        if (memcmp(input_command, (at_ctx.commands_list[idx]->syntax), command_size) == 0) {
-            // Update local pointer.
-            at_ctx.current_command = at_ctx.commands_list[idx];
-            break;
-        }
-    }
-    if (at_ctx.current_command == NULL) {
-        status = AT_ERROR_INTERNAL_COMMAND_NOT_FOUND;
+    AT_argument_type_t type = AT_ARGUMENT_TYPE_LAST;
+    uint32_t limit = 0;
+    // Check number of arguments.
+    if (_get_schema_size(schema) > AT_COMMAND_PARAMETER_MAX_NUMBER) {
+        status = AT_ERROR_COMMAND_SCHEMA;
         goto errors;
     }
-    // Check marker.
-    if (input_command[command_size] == AT_COMMAND_MARKER_EXECUTION) {
-        // Check if read command exists.
-        if ((at_ctx.current_command->execution_callback) == NULL) {
-            status = AT_ERROR_INTERNAL_COMMAND_EXECUTION_NOT_DEFINED;
-            goto errors;
-        }
-        // Execute command.
-        status = (at_ctx.current_command)->execution_callback(command_return_code);
+    // Check each item.
+    while ((*schema) != '\0') {
+        status = _get_schema_item(&schema, &type, &limit);
         if (status != AT_SUCCESS) {
             goto errors;
         }
-    } else if (input_command[command_size] == AT_COMMAND_MARKER_READ_HELP) {
-        // Check if read command exists.
-        if ((at_ctx.current_command->read_callback) == NULL) {
-            status = AT_ERROR_INTERNAL_COMMAND_READ_NOT_DEFINED;
-            goto errors;
-        }
-        // Execute command.
-        status = (at_ctx.current_command)->read_callback(command_return_code);
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _convert_arguments(const char *schema, AT_argument_slice_t *slices, uint32_t argc, AT_argument_t *arguments, uint8_t decode_flag, int32_t *error_code) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    uint32_t schema_size = _get_schema_size(schema);
+    uint32_t limit = 0;
+    uint32_t idx = 0;
+    AT_argument_t *argument = NULL;
+    // Check number of arguments.
+    if (argc != schema_size) {
+        (*error_code) = (int32_t) schema_size;
+        status = AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_NUMBER;
+        goto errors;
+    }
+    for (idx = 0; idx < argc; idx++) {
+        argument = &arguments[idx];
+        status = _get_schema_item(&schema, &argument->type, &limit);
         if (status != AT_SUCCESS) {
             goto errors;
         }
-    } else if ((input_command[command_size] == AT_COMMAND_MARKER_WRITE) || (type == AT_COMMAND_TYPE_BASIC)) {
-        // Check if write command exists.
-        if ((at_ctx.current_command->write_callback) == NULL) {
-            status = AT_ERROR_INTERNAL_COMMAND_WRITE_NOT_DEFINED;
-            goto errors;
-        }
-        if (type == AT_COMMAND_TYPE_BASIC) {
-            content = &input_command[command_size];
-        } else {
-            content = &input_command[command_size + 1];
-        }
-        // Search parameters.
-        while (*content == AT_COMMAND_PARAMETER_SEPARATOR) {
-            command_argv[command_argc++] = NULL;
-            content++;
-        }
-        // Parse parameter.
-        while ((parameter = strtok_r(content, separators, &content))) {
-            command_argv[command_argc++] = parameter;
-            while (*content == AT_COMMAND_PARAMETER_SEPARATOR) {
-                command_argv[command_argc++] = NULL;
-                content++;
+        switch (argument->type) {
+        case AT_ARGUMENT_TYPE_UNSIGNED:
+            status = _parse_unsigned(slices[idx].data, slices[idx].size, &argument->value.u32);
+            if ((status == AT_SUCCESS) && (argument->value.u32 > limit)) {
+                status = AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_VALUE;
+            }
+            break;
+        case AT_ARGUMENT_TYPE_SIGNED:
+            status = _parse_signed(slices[idx].data, slices[idx].size, limit, &argument->value.i32);
+            break;
+        case AT_ARGUMENT_TYPE_HEX:
+            // Decode in place (or only check characters).
+            argument->value.hex.data = (uint8_t *) slices[idx].data;
+            argument->value.hex.size = slices[idx].size / 2;
+            status = _decode_hex(slices[idx].data, slices[idx].size, ((decode_flag != 0) ? argument->value.hex.data : NULL));
+            if ((status == AT_SUCCESS) && (limit != 0) && (argument->value.hex.size != limit)) {
+                status = AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_VALUE;
+            }
+            break;
+        default:
+            argument->value.str.data = slices[idx].data;
+            argument->value.str.size = slices[idx].size;
+            if ((limit != 0) && (argument->value.str.size > limit)) {
+                status = AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_VALUE;
             }
+            break;
         }
-        // Execute command.
-        status = (at_ctx.current_command)->write_callback(command_argc, command_argv, command_return_code);
         if (status != AT_SUCCESS) {
+            (*error_code) = (int32_t) idx;
             goto errors;
         }
-    } else {
-        status = AT_ERROR_INTERNAL_COMMAND_MARKER_NOT_DEFINED;
-        goto errors;
     }
-    return AT_SUCCESS;
 errors:
     return status;
 }
 
 /*******************************************************************/
-AT_status_t _print_command_header(AT_command_type_t type) {
+AT_status_t _parse_bit(uint32_t argc, char *argv[], uint8_t *bit) {
     // Local variables.
     AT_status_t status = AT_SUCCESS;
-    char header[2] = {0x00};
-    // Check type.
-    if (type >= AT_COMMAND_TYPE_LAST) {
-        status = AT_ERROR_COMMAND_TYPE;
+    uint32_t tmp_int = 0;
+    // Check number of arguments.
+    if (argc != 1) {
+        status = AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_NUMBER;
         goto errors;
     }
-    header[0] = AT_COMMAND_HEADER[type];
-    status = _print(header);
+    // Parse parameter.
+    status = _parse_unsigned(argv[0], ((argv[0] == NULL) ? 0 : strlen(argv[0])), &tmp_int);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    if (tmp_int > 1) {
+        status = AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_VALUE;
+        goto errors;
+    }
+    (*bit) = (uint8_t) tmp_int;
+    return AT_SUCCESS;
 errors:
     return status;
 }
 
 /*******************************************************************/
-AT_status_t _print_help(AT_command_type_t type) {
+AT_status_t _echo_execution_callback(int32_t *error_code) {
     // Local variables.
     AT_status_t status = AT_SUCCESS;
-    uint32_t idx = 0;
-    char marker[2] = {0x00};
-    // Check number of registered commands.
-    if (at_ctx.commands_count[type] == 0) {
-        status = _print_line("    None");
-        if (status != AT_SUCCESS) {
-            goto errors;
-        }
-    } else {
-        // Commands loop.
-        for (idx = 0; idx < (sizeof(at_ctx.commands_list) / sizeof(AT_command_t *)); idx++) {
-            // Check existence and type.
-            if ((at_ctx.commands_list[idx] != NULL) && ((at_ctx.commands_list[idx]->type) == type)) {
-                // Print common syntax.
-                status = _print("    ");
-                if (status != AT_SUCCESS) {
-                    goto errors;
-                }
-                status = _print(at_ctx.commands_list[idx]->syntax);
-                if (status != AT_SUCCESS) {
-                    goto errors;
-                }
-                status = _print(" : ");
-                if (status != AT_SUCCESS) {
-                    goto errors;
-                }
-                status = _print_line(at_ctx.commands_list[idx]->help);
-                if (status != AT_SUCCESS) {
-                    goto errors;
-                }
-                // Execution callback.
-                if (at_ctx.commands_list[idx]->execution_callback != NULL) {
-                    status = _print(AT_COMMAND_HEADER_HELP);
-                    if (status != AT_SUCCESS) {
-                        goto errors;
-                    }
-                    status = _print(AT_HEADER);
-                    if (status != AT_SUCCESS) {
-                        goto errors;
-                    }
-                    status = _print_command_header(type);
-                    if (status != AT_SUCCESS) {
-                        goto errors;
-                    }
-                    status = _print(at_ctx.commands_list[idx]->syntax);
-                    if (status != AT_SUCCESS) {
-                        goto errors;
-                    }
-                    status = _print(" : ");
-                    if (status != AT_SUCCESS) {
-                        goto errors;
-                    }
-                    status = _print_line(at_ctx.commands_list[idx]->execution_help);
-                    if (status != AT_SUCCESS) {
-                        goto errors;
-                    }
-                }
-                // Write callback.
-                if ((at_ctx.commands_list[idx]->write_callback) != NULL) {
-                    status = _print(AT_COMMAND_HEADER_HELP);
-                    if (status != AT_SUCCESS) {
-                        goto errors;
-                    }
-                    status = _print(AT_HEADER);
-                    if (status != AT_SUCCESS) {
-                        goto errors;
-                    }
-                    status = _print_command_header(type);
-                    if (status != AT_SUCCESS) {
-                        goto errors;
-                    }
-                    status = _print(at_ctx.commands_list[idx]->syntax);
-                    if (status != AT_SUCCESS) {
-                        goto errors;
-                    }
-                    if (type != AT_COMMAND_TYPE_BASIC) {
-                        marker[0] = AT_COMMAND_MARKER_WRITE;
-                        status = _print(marker);
-                        if (status != AT_SUCCESS) {
-                            goto errors;
-                        }
-                    }
-                    status = _print(at_ctx.commands_list[idx]->write_arguments);
-                    if (status != AT_SUCCESS) {
-                        goto errors;
-                    }
-                    status = _print(" : ");
-                    if (status != AT_SUCCESS) {
-                        goto errors;
-                    }
-                    status = _print_line(at_ctx.commands_list[idx]->write_help);
-                    if (status != AT_SUCCESS) {
-                        goto errors;
-                    }
-                }
-                // Read callback.
-                if ((at_ctx.commands_list[idx]->read_callback) != NULL) {
-                    status = _print(AT_COMMAND_HEADER_HELP);
-                    if (status != AT_SUCCESS) {
-                        goto errors;
-                    }
-                    status = _print(AT_HEADER);
-                    if (status != AT_SUCCESS) {
-                        goto errors;
-                    }
-                    status = _print_command_header(type);
-                    if (status != AT_SUCCESS) {
-                        goto errors;
-                    }
-                    status = _print(at_ctx.commands_list[idx]->syntax);
-                    if (status != AT_SUCCESS) {
-                        goto errors;
-                    }
-                    marker[0] = AT_COMMAND_MARKER_READ_HELP;
-                    status = _print(marker);
-                    if (status != AT_SUCCESS) {
-                        goto errors;
-                    }
-                    status = _print(" : ");
-                    if (status != AT_SUCCESS) {
-                        goto errors;
-                    }
-                    status = _print_line(at_ctx.commands_list[idx]->read_help);
-                    if (status != AT_SUCCESS) {
-                        goto errors;
-                    }
-                }
-            }
-        }
-    }
-errors:
+    AT_context_t *ctx = _get_current_context();
+    // Reset error code.
+    (*error_code) = 0;
+    // Disable echo.
+    ctx->flags.field.echo = 0;
     return status;
 }
 
-/*** AT local functions ***/
-
 /*******************************************************************/
-AT_status_t AT_init(AT_config_t *config) {
+AT_status_t _echo_write_callback(uint32_t argc, char *argv[], int32_t *error_code) {
     // Local variables.
     AT_status_t status = AT_SUCCESS;
-    AT_HW_API_config_t hw_config;
-    // Check parameter.
-    if (config->process_callback == NULL) {
-        status = AT_ERROR_NULL_PARAMETER;
-        goto errors;
-    }
-    // Init context.
-    at_ctx.flags.field.quiet = ((config->default_quiet_flag) == 0) ? 0 : 1;
-    at_ctx.flags.field.verbose = ((config->default_verbose_flag) == 0) ? 0 : 1;
-    at_ctx.flags.field.echo = ((config->default_echo_flag) == 0) ? 0 : 1;
-    at_ctx.process_callback = config->process_callback;
-    // Init hardware interface.
-    hw_config.rx_irq_callback = &_rx_irq_callback;
-    status = AT_HW_API_init(&hw_config);
-    if (status != AT_SUCCESS) {
-        goto errors;
-    }
-    // Register basic commands.
-    status = AT_register_command(&AT_COMMAND_ECHO);
-    if (status != AT_SUCCESS) {
-        goto errors;
-    }
-    status = AT_register_command(&AT_COMMAND_VERBOSE);
+    AT_context_t *ctx = _get_current_context();
+    uint8_t enable = 0;
+    // Reset error code.
+    (*error_code) = 0;
+    // Check number of arguments.
+    status = _parse_bit(argc, argv, &enable);
     if (status != AT_SUCCESS) {
         goto errors;
     }
-    status = AT_register_command(&AT_COMMAND_QUIET);
+    // Update echo.
+    ctx->flags.field.echo = enable;
+    return AT_SUCCESS;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+AT_status_t _verbose_execution_callback(int32_t *error_code) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_context_t *ctx = _get_current_context();
+    // Reset error code.
+    (*error_code) = 0;
+    // Disable verbose.
+    ctx->flags.field.verbose = 0;
+    return status;
+}
+
+/*******************************************************************/
+AT_status_t _verbose_write_callback(uint32_t argc, char *argv[], int32_t *error_code) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_context_t *ctx = _get_current_context();
+    uint8_t enable = 0;
+    // Reset error code.
+    (*error_code) = 0;
+    // Check number of arguments.
+    status = _parse_bit(argc, argv, &enable);
     if (status != AT_SUCCESS) {
         goto errors;
     }
+    // Update echo.
+    ctx->flags.field.verbose = enable;
     return AT_SUCCESS;
 errors:
     return status;
 }
 
 /*******************************************************************/
-AT_status_t AT_de_init(void) {
+AT_status_t _quiet_execution_callback(int32_t *error_code) {
     // Local variables.
     AT_status_t status = AT_SUCCESS;
-    // Release hardware interface.
-    status = AT_HW_API_de_init();
+    AT_context_t *ctx = _get_current_context();
+    // Reset error code.
+    (*error_code) = 0;
+    // Disable verbose.
+    ctx->flags.field.quiet = 0;
+    return status;
+}
+
+/*******************************************************************/
+AT_status_t _quiet_write_callback(uint32_t argc, char *argv[], int32_t *error_code) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_context_t *ctx = _get_current_context();
+    uint8_t enable = 0;
+    // Reset error code.
+    (*error_code) = 0;
+    // Check number of arguments.
+    status = _parse_bit(argc, argv, &enable);
     if (status != AT_SUCCESS) {
         goto errors;
     }
+    // Update echo.
+    ctx->flags.field.quiet = enable;
+    return AT_SUCCESS;
 errors:
     return status;
 }
 
+#ifdef AT_ASYNCHRONOUS_TX
 /*******************************************************************/
-AT_status_t AT_register_command(const AT_command_t *command) {
+static AT_status_t _tx_start(AT_context_t *ctx) {
     // Local variables.
-    AT_status_t status = AT_ERROR_COMMANDS_LIST_FULL;
-    uint32_t idx;
-    // Check parameter.
-    if (command == NULL) {
-        status = AT_ERROR_NULL_PARAMETER;
+    AT_status_t status = AT_SUCCESS;
+    AT_tx_size_t read_index = ctx->tx_read_index;
+    AT_tx_size_t write_index = ctx->tx_write_index;
+    // Check buffer.
+    if (read_index == write_index) {
+        ctx->tx_busy_size = 0;
         goto errors;
     }
-    // Check write arguments.
-    if (((command->write_callback) != NULL) && ((command->write_arguments) == NULL)) {
-        status = AT_ERROR_WRITE_CALLBACK_WITHOUT_PARAMETER;
+    // Send contiguous data (busy size must be set before starting since the transfer may complete immediately).
+    ctx->tx_busy_size = (write_index > read_index) ? (write_index - read_index) : (ctx->tx_wrap_index - read_index);
+    AT_MEMORY_BARRIER();
+#ifdef AT_METRICS
+    ctx->metrics.tx_bytes += ctx->tx_busy_size;
+    ctx->metrics.tx_writes++;
+#endif
+    status = ctx->hw_ops->write_async(ctx->hw_context, &ctx->tx_buffer[read_index], ctx->tx_busy_size);
+    if (status != AT_SUCCESS) {
+        // Discard staged data.
+        ctx->tx_read_index = write_index;
+        ctx->tx_wrap_index = AT_TX_BUFFER_SIZE;
+        ctx->tx_busy_size = 0;
         goto errors;
     }
-    // Check type.
-    if ((command->type) >= AT_COMMAND_TYPE_LAST) {
-        status = AT_ERROR_COMMAND_TYPE;
-        goto errors;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static void _tx_done_callback(AT_context_t *ctx) {
+    // Local variables.
+    uint32_t read_index = (uint32_t) ctx->tx_read_index + ctx->tx_busy_size;
+    // Release transmitted data (the end of the ring is skipped when a reply restarted from its beginning).
+    if (read_index >= ctx->tx_wrap_index) {
+        read_index = 0;
+        ctx->tx_wrap_index = AT_TX_BUFFER_SIZE;
     }
-    // Check if command is already registered.
-    for (idx = 0; idx < (sizeof(at_ctx.commands_list) / sizeof(AT_command_t *)); idx++) {
-        // Compare commands.
-        if (at_ctx.commands_list[idx] == command) {
-            status = AT_ERROR_COMMAND_ALREADY_REGISTERED;
-            goto errors;
+    ctx->tx_read_index = (AT_tx_size_t) read_index;
+    // Chain next transfer.
+    _tx_start(ctx);
+    // Ask for processing of the output which did not fit in the ring.
+    if ((ctx->tx_busy_size == 0) && (ctx->tx_wait_flag != 0)) {
+        ctx->tx_wait_flag = 0;
+        if (ctx->process_callback != NULL) {
+            ctx->process_callback();
         }
     }
-    // Search free location in list.
-    for (idx = 0; idx < (sizeof(at_ctx.commands_list) / sizeof(AT_command_t *)); idx++) {
-        // Check free index.
-        if (at_ctx.commands_list[idx] == NULL) {
-            // Register command and exit.
-            at_ctx.commands_list[idx] = command;
-            at_ctx.commands_count[command->type]++;
-            status = AT_SUCCESS;
-            break;
-        }
+}
+
+/*******************************************************************/
+static AT_status_t _tx_flush(AT_context_t *ctx) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    // Start transfer if the interface is idle, otherwise the TX done interrupt will chain it.
+    if (ctx->tx_busy_size == 0) {
+        status = _tx_start(ctx);
     }
-    return AT_SUCCESS;
-errors:
     return status;
 }
 
 /*******************************************************************/
-AT_status_t AT_unregister_command(const AT_command_t *command) {
+static uint32_t _tx_get_free_size(AT_context_t *ctx, uint8_t contiguous_flag) {
     // Local variables.
-    AT_status_t status = AT_ERROR_COMMAND_NOT_REGISTERED;
-    uint32_t idx = 0;
-    // Search command in list.
-    for (idx = 0; idx < (sizeof(at_ctx.commands_list) / sizeof(AT_command_t *)); idx++) {
-        // Check pointer.
-        if (at_ctx.commands_list[idx] == command) {
-            // Release index and exit.
-            at_ctx.commands_list[idx] = NULL;
-            at_ctx.commands_count[command->type]--;
-            status = AT_SUCCESS;
+    AT_tx_size_t read_index = ctx->tx_read_index;
+    AT_tx_size_t write_index = ctx->tx_write_index;
+    // One byte is kept free to distinguish full and empty states.
+    if (read_index > write_index) {
+        return (uint32_t) (read_index - write_index - 1);
+    }
+    if (contiguous_flag != 0) {
+        return (uint32_t) (AT_TX_BUFFER_SIZE - write_index - ((read_index == 0) ? 1 : 0));
+    }
+    return (uint32_t) (AT_TX_BUFFER_SIZE - write_index + read_index - 1);
+}
+
+/*******************************************************************/
+static uint32_t _tx_get_contiguous_size(AT_context_t *ctx, uint32_t size) {
+    // Local variables.
+    AT_tx_size_t read_index = 0;
+    // The indexes are only moved while no transfer is in progress.
+    if (ctx->tx_busy_size == 0) {
+        AT_MEMORY_BARRIER();
+        read_index = ctx->tx_read_index;
+        if (read_index == ctx->tx_write_index) {
+            // Restart from the beginning of the ring once all data is transmitted.
+            ctx->tx_read_index = 0;
+            ctx->tx_write_index = 0;
+            ctx->tx_wrap_index = AT_TX_BUFFER_SIZE;
+        } else if ((read_index < ctx->tx_write_index) && (read_index > size) && (_tx_get_free_size(ctx, 1) < size)) {
+            // Restart from the beginning of the ring, the staged data is sent up to the wrap index.
+            ctx->tx_wrap_index = ctx->tx_write_index;
+            ctx->tx_write_index = 0;
+        }
+    }
+    return _tx_get_free_size(ctx, 1);
+}
+
+/*******************************************************************/
+static uint32_t _tx_copy(AT_context_t *ctx, const uint8_t *data, uint32_t data_size) {
+    // Local variables.
+    uint32_t written_size = 0;
+    uint32_t copy_size = 0;
+    // Fill the contiguous free areas of the ring.
+    while (written_size < data_size) {
+        copy_size = _tx_get_free_size(ctx, 1);
+        if (copy_size == 0) {
             break;
         }
+        if (copy_size > (data_size - written_size)) {
+            copy_size = (data_size - written_size);
+        }
+        memcpy(&ctx->tx_buffer[ctx->tx_write_index], &data[written_size], copy_size);
+        AT_MEMORY_BARRIER();
+        ctx->tx_write_index = (AT_tx_size_t) ((ctx->tx_write_index + copy_size) % AT_TX_BUFFER_SIZE);
+        written_size += copy_size;
     }
-    return status;
+    return written_size;
 }
 
 /*******************************************************************/
-AT_status_t AT_process(void) {
+static void _tx_drain(AT_context_t *ctx) {
     // Local variables.
-    AT_status_t status = AT_SUCCESS;
-    int32_t command_return_code = 0;
-    uint32_t command_start_idx = (sizeof(AT_HEADER) - 1);
-    uint32_t idx = 0;
-    // Check process flag.
-    if (at_ctx.flags.field.process == 0) {
-        goto end;
+    uint32_t copy_size = 0;
+    // Move the staged replies to the ring, in order.
+    if (ctx->tx_reply_size == 0) {
+        return;
     }
-    // Clear flag.
-    at_ctx.flags.field.process = 0;
-    // Echo.
-    if (at_ctx.flags.field.echo != 0) {
-        _print_line(at_ctx.rx_buffer);
+    copy_size = _tx_copy(ctx, ctx->tx_reply_buffer, ctx->tx_reply_size);
+    ctx->tx_reply_size -= copy_size;
+    memmove(ctx->tx_reply_buffer, &ctx->tx_reply_buffer[copy_size], ctx->tx_reply_size);
+}
+
+/*******************************************************************/
+static uint32_t _tx_get_ring_size(AT_context_t *ctx, uint32_t size, uint8_t contiguous_flag) {
+    // The staged replies are written first, the ring is only available once they are all moved.
+    _tx_drain(ctx);
+    if (ctx->tx_reply_size != 0) {
+        return 0;
     }
-    if (status != AT_SUCCESS) {
+    return (contiguous_flag != 0) ? _tx_get_contiguous_size(ctx, size) : _tx_get_free_size(ctx, 0);
+}
+
+/*******************************************************************/
+static AT_status_t _tx_check(AT_context_t *ctx, uint32_t size, uint8_t contiguous_flag) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    uint32_t free_size = 0;
+    // Replies are not written in the middle of a suspended output.
+    if (ctx->tx_unit != AT_TX_UNIT_NONE) {
+        status = AT_ERROR_TX_BUSY;
         goto errors;
     }
-    // Check header.
-    if (memcmp((uint8_t *) at_ctx.rx_buffer, AT_HEADER, command_start_idx) == 0) {
-        // Check marker.
-        switch (at_ctx.rx_buffer[command_start_idx]) {
-        case AT_COMMAND_MARKER_EXECUTION: // Ping commands AT.
-            break;
-            // Read.
-        case AT_COMMAND_MARKER_READ_HELP: // Help commands AT?.
-            // Check last character is a execution marker.
-            if (at_ctx.rx_buffer[command_start_idx + 1] == AT_COMMAND_MARKER_EXECUTION) {
-                status = _print_line("Basic commands");
-                if (status != AT_SUCCESS) {
-                    goto errors;
-                }
-                status = _print_help(AT_COMMAND_TYPE_BASIC);
-                if (status != AT_SUCCESS) {
-                    goto errors;
-                }
-                status = _print_line("Extended commands");
-                if (status != AT_SUCCESS) {
-                    goto errors;
-                }
-                status = _print_help(AT_COMMAND_TYPE_EXTENDED);
-                if (status != AT_SUCCESS) {
-                    goto errors;
-                }
-                status = _print_line("Debug commands");
-                if (status != AT_SUCCESS) {
-                    goto errors;
-                }
-                status = _print_help(AT_COMMAND_TYPE_DEBUG);
-                if (status != AT_SUCCESS) {
-                    goto errors;
-                }
-            } else {
-                status = AT_ERROR_INTERNAL_COMMAND_PARSING;
-            }
-            break;
-        case AT_COMMAND_HEADER_EXTENDED: // Extended commands AT$.
-            status = _parse_and_execute_command(&at_ctx.rx_buffer[command_start_idx + 1], AT_COMMAND_TYPE_EXTENDED, &command_return_code);
-            if (status != AT_SUCCESS) {
-                goto errors;
-            }
-            break;
-        case AT_COMMAND_HEADER_DEBUG: // Debug commands AT!.
-            status = _parse_and_execute_command(&at_ctx.rx_buffer[command_start_idx + 1], AT_COMMAND_TYPE_DEBUG, &command_return_code);
-            if (status != AT_SUCCESS) {
-                goto errors;
-            }
-            break;
-        default: // Basic command AT.
-            status = _parse_and_execute_command(&at_ctx.rx_buffer[command_start_idx], AT_COMMAND_TYPE_BASIC, &command_return_code);
-            if (status != AT_SUCCESS) {
-                goto errors;
-            }
+    free_size = _tx_get_ring_size(ctx, size, contiguous_flag);
+    if (free_size < size) {
+        // Start the transfer, which may complete immediately.
+        status = _tx_flush(ctx);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+        free_size = _tx_get_ring_size(ctx, size, contiguous_flag);
+    }
+    // The replies of the running command which do not fit in the ring are staged.
+    if ((contiguous_flag == 0) && (ctx->flags.field.running != 0)) {
+        free_size += (AT_TX_REPLY_SIZE - ctx->tx_reply_size);
+    }
+    // The caller retries later when the ring is only busy (outside of a command).
+    if (free_size < size) {
+        status = ((size >= AT_TX_BUFFER_SIZE) || ((contiguous_flag == 0) && (ctx->flags.field.running != 0))) ? AT_ERROR_TX_BUFFER_SIZE : AT_ERROR_TX_BUSY;
+        goto errors;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _tx_write(AT_context_t *ctx, const uint8_t *data, uint32_t data_size) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    uint32_t copy_size = (data_size < ctx->tx_skip_size) ? data_size : ctx->tx_skip_size;
+    // Skip the bytes of a resumed unit which were written before its suspension.
+    ctx->tx_skip_size -= copy_size;
+    ctx->tx_unit_size += copy_size;
+    data += copy_size;
+    data_size -= copy_size;
+    // The end of a suspended unit is written once it is resumed.
+    if (ctx->tx_suspended_flag != 0) {
+        goto errors;
+    }
+    while (data_size > 0) {
+        // The staged replies are written first.
+        _tx_drain(ctx);
+        copy_size = (ctx->tx_reply_size == 0) ? _tx_copy(ctx, data, data_size) : 0;
+        ctx->tx_unit_size += copy_size;
+        data += copy_size;
+        data_size -= copy_size;
+        // The ring is released by the TX done callback once the transfer in progress is done.
+        if ((data_size == 0) || (ctx->tx_busy_size != 0)) {
             break;
         }
-    } else {
-        status = AT_ERROR_INTERNAL_COMMAND_PARSING;
+        // Start the transfer, which may complete immediately.
+        status = _tx_flush(ctx);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+    }
+    if (data_size == 0) {
+        goto errors;
+    }
+    // The TX done callback is never waited for: a unit is suspended, the replies of the running command are staged.
+    if (ctx->tx_unit != AT_TX_UNIT_NONE) {
+        ctx->tx_suspended_flag = 1;
+        goto errors;
+    }
+    if (ctx->flags.field.running == 0) {
+        status = AT_ERROR_TX_BUSY;
+        goto errors;
+    }
+    if (data_size > (AT_TX_REPLY_SIZE - ctx->tx_reply_size)) {
+        status = AT_ERROR_TX_BUFFER_SIZE;
+        goto errors;
+    }
+    memcpy(&ctx->tx_reply_buffer[ctx->tx_reply_size], data, data_size);
+    ctx->tx_reply_size += data_size;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _tx_reserve(AT_context_t *ctx, uint32_t size, char **area) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    // The end marker written by AT_reply_commit() is reserved too.
+    status = _tx_check(ctx, (size + (sizeof(AT_REPLY_END) - 1)), 1);
+    if (status == AT_SUCCESS) {
+        (*area) = (char *) &ctx->tx_buffer[ctx->tx_write_index];
+        goto errors;
+    }
+    // The replies of the running command are reserved after the staged replies when the ring is busy.
+    if (((status != AT_ERROR_TX_BUSY) && (status != AT_ERROR_TX_BUFFER_SIZE)) || (ctx->tx_unit != AT_TX_UNIT_NONE) || (ctx->flags.field.running == 0)) {
+        goto errors;
+    }
+    if ((size + (sizeof(AT_REPLY_END) - 1)) > (AT_TX_REPLY_SIZE - ctx->tx_reply_size)) {
+        status = AT_ERROR_TX_BUFFER_SIZE;
+        goto errors;
     }
+    status = AT_SUCCESS;
+    (*area) = (char *) &ctx->tx_reply_buffer[ctx->tx_reply_size];
 errors:
-    // Print status.
-    _print_command_status(status, command_return_code);
-    at_ctx.flags.field.pending = 0;
-    // Reset buffer.
-    for (idx = 0; idx < AT_BUFFER_SIZE; idx++) {
-        at_ctx.rx_buffer[idx] = 0x00;
+    return status;
+}
+
+/*******************************************************************/
+static void _tx_commit(AT_context_t *ctx, uint32_t size) {
+    // Data was written in place in the reserved area (nothing is drained before the commit).
+    if ((ctx->reply_area >= (char *) ctx->tx_reply_buffer) && (ctx->reply_area < (char *) &ctx->tx_reply_buffer[AT_TX_REPLY_SIZE])) {
+        ctx->tx_reply_size += size;
+        return;
     }
-    at_ctx.rx_buffer_size = 0;
-end:
+    AT_MEMORY_BARRIER();
+    ctx->tx_write_index = (AT_tx_size_t) ((ctx->tx_write_index + size) % AT_TX_BUFFER_SIZE);
+}
+
+/*******************************************************************/
+static AT_tx_unit_t _tx_get_unit(AT_context_t *ctx) {
+    return (AT_tx_unit_t) ctx->tx_unit;
+}
+
+/*******************************************************************/
+static uint8_t _tx_begin_unit(AT_context_t *ctx, AT_tx_unit_t unit) {
+    // Local variables.
+    uint8_t resume_flag = (ctx->tx_unit == unit) ? 1 : 0;
+    // A resumed unit is generated again, the bytes written before its suspension are skipped.
+    ctx->tx_unit = (uint8_t) unit;
+    ctx->tx_skip_size = (resume_flag != 0) ? ctx->tx_unit_size : 0;
+    ctx->tx_unit_size = 0;
+    ctx->tx_suspended_flag = 0;
+    return resume_flag;
+}
+
+/*******************************************************************/
+static AT_status_t _tx_end_unit(AT_context_t *ctx, AT_status_t status) {
+    // The unit is resumed once the TX buffer is empty.
+    if ((ctx->tx_suspended_flag != 0) && (status == AT_SUCCESS)) {
+        return AT_PENDING;
+    }
+    ctx->tx_unit = AT_TX_UNIT_NONE;
+    ctx->tx_suspended_flag = 0;
+    ctx->tx_skip_size = 0;
     return status;
 }
 
+#ifdef AT_METRICS
 /*******************************************************************/
-AT_status_t AT_send_reply(const AT_command_t *command, char *reply) {
+static uint8_t _tx_is_suspended(AT_context_t *ctx) {
+    return ctx->tx_suspended_flag;
+}
+#endif
+
+/*******************************************************************/
+static uint8_t _tx_wait(AT_context_t *ctx) {
+    // Move the staged replies and start the transfer, which may complete immediately.
+    do {
+        _tx_drain(ctx);
+        if (_tx_flush(ctx) != AT_SUCCESS) {
+            // Staged replies are discarded with the ring content.
+            ctx->tx_reply_size = 0;
+        }
+    } while ((ctx->tx_reply_size != 0) && (ctx->tx_busy_size == 0));
+    // The TX done callback asks for processing once the ring is empty.
+    ctx->tx_wait_flag = 1;
+    AT_MEMORY_BARRIER();
+    if ((ctx->tx_busy_size != 0) || (ctx->tx_read_index != ctx->tx_write_index) || (ctx->tx_reply_size != 0)) {
+        return 1;
+    }
+    ctx->tx_wait_flag = 0;
+    // Restart from the beginning of the ring.
+    ctx->tx_read_index = 0;
+    ctx->tx_write_index = 0;
+    ctx->tx_wrap_index = AT_TX_BUFFER_SIZE;
+    return 0;
+}
+
+/*******************************************************************/
+static void _tx_suspend(AT_context_t *ctx) {
+    // AT_process() is called back by the TX done callback once the ring is empty.
+    if ((_tx_wait(ctx) == 0) && (ctx->process_callback != NULL)) {
+        ctx->process_callback();
+    }
+}
+#else
+/*******************************************************************/
+static AT_status_t _tx_flush(AT_context_t *ctx) {
     // Local variables.
     AT_status_t status = AT_SUCCESS;
-    const AT_command_t *command_ptr = NULL;
-    // Check parameters.
-    if (reply == NULL) {
-        status = AT_ERROR_NULL_PARAMETER;
+    // Check buffer.
+    if (ctx->tx_buffer_size == 0) {
         goto errors;
     }
-    if (reply[0] == '\0') {
-        status = AT_ERROR_NULL_PARAMETER;
+#ifdef AT_METRICS
+    ctx->metrics.tx_bytes += ctx->tx_buffer_size;
+    ctx->metrics.tx_writes++;
+#endif
+    // Write staged data at once.
+    status = ctx->hw_ops->write(ctx->hw_context, ctx->tx_buffer, ctx->tx_buffer_size);
+    ctx->tx_buffer_size = 0;
+    if (status != AT_SUCCESS) {
         goto errors;
     }
-    // Update current command pointer.
-    command_ptr = (command != NULL) ? command : at_ctx.current_command;
-    // Check pointer.
-    if (command_ptr != NULL) {
-        // Print header.
-        status = _print_command_header(command_ptr->type);
-        if (status != AT_SUCCESS) {
-            goto errors;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _tx_write(AT_context_t *ctx, const uint8_t *data, uint32_t data_size) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    uint32_t copy_size = 0;
+    while (data_size > 0) {
+        // Flush buffer when full.
+        if (ctx->tx_buffer_size >= AT_TX_BUFFER_SIZE) {
+            status = _tx_flush(ctx);
+            if (status != AT_SUCCESS) {
+                goto errors;
+            }
         }
-        status = _print(command_ptr->syntax);
-        if (status != AT_SUCCESS) {
-            goto errors;
+        copy_size = AT_TX_BUFFER_SIZE - ctx->tx_buffer_size;
+        if (copy_size > data_size) {
+            copy_size = data_size;
         }
-        status = _print(":");
+        memcpy(&ctx->tx_buffer[ctx->tx_buffer_size], data, copy_size);
+        ctx->tx_buffer_size += copy_size;
+        data += copy_size;
+        data_size -= copy_size;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _tx_reserve(AT_context_t *ctx, uint32_t size, char **area) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    // Check size.
+    if (size > AT_TX_BUFFER_SIZE) {
+        status = AT_ERROR_TX_BUFFER_SIZE;
+        goto errors;
+    }
+    // Flush staged data if the remaining space is too small.
+    if ((uint32_t) (AT_TX_BUFFER_SIZE - ctx->tx_buffer_size) < size) {
+        status = _tx_flush(ctx);
         if (status != AT_SUCCESS) {
             goto errors;
         }
     }
-    status = _print(reply);
+    (*area) = (char *) &ctx->tx_buffer[ctx->tx_buffer_size];
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static void _tx_commit(AT_context_t *ctx, uint32_t size) {
+    // Data was written in place in the reserved area.
+    ctx->tx_buffer_size = (AT_tx_size_t) (ctx->tx_buffer_size + size);
+}
+
+/*******************************************************************/
+static AT_status_t _tx_check(AT_context_t *ctx, uint32_t size, uint8_t contiguous_flag) {
+    // Staged data is written when the buffer is full, any size fits.
+    ((void) ctx);
+    ((void) size);
+    ((void) contiguous_flag);
+    return AT_SUCCESS;
+}
+
+/*******************************************************************/
+static AT_tx_unit_t _tx_get_unit(AT_context_t *ctx) {
+    // Synchronous output is never suspended.
+    ((void) ctx);
+    return AT_TX_UNIT_NONE;
+}
+
+/*******************************************************************/
+static uint8_t _tx_begin_unit(AT_context_t *ctx, AT_tx_unit_t unit) {
+    ((void) ctx);
+    ((void) unit);
+    return 0;
+}
+
+/*******************************************************************/
+static AT_status_t _tx_end_unit(AT_context_t *ctx, AT_status_t status) {
+    ((void) ctx);
+    return status;
+}
+
+#ifdef AT_METRICS
+/*******************************************************************/
+static uint8_t _tx_is_suspended(AT_context_t *ctx) {
+    ((void) ctx);
+    return 0;
+}
+#endif
+
+/*******************************************************************/
+static uint8_t _tx_wait(AT_context_t *ctx) {
+    ((void) ctx);
+    return 0;
+}
+
+/*******************************************************************/
+static void _tx_suspend(AT_context_t *ctx) {
+    ((void) ctx);
+}
+#endif
+
+#ifdef AT_READ_CACHE
+/*******************************************************************/
+static void _read_cache_append(AT_context_t *ctx, const char *data, uint32_t size) {
+    // Local variables.
+    AT_read_cache_t *entry = ctx->read_cache_capture;
+    // Replies larger than the entry are not cached.
+    if (((uint32_t) entry->size + size) > AT_READ_CACHE_SIZE) {
+        ctx->read_cache_overflow = 1;
+        return;
+    }
+    memcpy(&(entry->buffer[entry->size]), data, size);
+    entry->size = (uint16_t) (entry->size + size);
+}
+#endif
+
+/*******************************************************************/
+static AT_status_t _print_tab(AT_context_t *ctx, char *tab, uint32_t tab_size) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    // Check quiet flag.
+    if ((ctx->flags.field.quiet != 0) || (tab_size == 0)) {
+        goto errors;
+    }
+#ifdef AT_READ_CACHE
+    // Capture the replies of a cached read command.
+    if (ctx->read_cache_capture != NULL) {
+        _read_cache_append(ctx, tab, tab_size);
+    }
+#endif
+    // Write text.
+    status = _tx_write(ctx, (uint8_t *) tab, tab_size);
     if (status != AT_SUCCESS) {
         goto errors;
     }
-    status = _end_line();
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _print(AT_context_t *ctx, const char *text) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    // Write end marker.
+    status = _print_tab(ctx, (char *) text, strlen(text));
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _end_line(AT_context_t *ctx) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    // Write end marker.
+    status = _print_tab(ctx, AT_REPLY_END, 2);
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _print_line(AT_context_t *ctx, const char *line) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    // Write text.
+    status = _print(ctx, line);
     if (status != AT_SUCCESS) {
         goto errors;
     }
-    return AT_SUCCESS;
+    // Write end marker.
+    status = _end_line(ctx);
 errors:
     return status;
 }
+
+/*******************************************************************/
+static uint32_t _get_reply_header_size(const AT_command_t *command) {
+    // Header, syntax and separator.
+    if (command == NULL) {
+        return 0;
+    }
+    return (strlen(command->syntax) + 1 + ((AT_COMMAND_HEADER[command->type] != '\0') ? 1 : 0));
+}
+
+/*******************************************************************/
+static AT_status_t _print_number(AT_context_t *ctx, uint32_t magnitude, uint8_t negative) {
+    // Local variables.
+    char text[AT_NUMBER_TEXT_SIZE];
+    uint32_t idx = AT_NUMBER_TEXT_SIZE;
+    // Build digits from the end of the buffer.
+    do {
+        text[--idx] = (char) ('0' + (magnitude % 10));
+        magnitude /= 10;
+    } while (magnitude != 0);
+    // Add sign.
+    if (negative != 0) {
+        text[--idx] = '-';
+    }
+    return _print_tab(ctx, &text[idx], (AT_NUMBER_TEXT_SIZE - idx));
+}
+
+/*******************************************************************/
+static AT_status_t _print_decimal(AT_context_t *ctx, int32_t value) {
+    return _print_number(ctx, ((value < 0) ? (0 - (uint32_t) value) : ((uint32_t) value)), ((value < 0) ? 1 : 0));
+}
+
+/*******************************************************************/
+static AT_status_t _print_hex(AT_context_t *ctx, uint32_t value, uint32_t min_digits) {
+    // Local variables.
+    char text[AT_NUMBER_TEXT_SIZE];
+    uint32_t idx = AT_NUMBER_TEXT_SIZE;
+    uint32_t digits = 0;
+    // Build digits from the end of the buffer.
+    do {
+        text[--idx] = AT_HEX_DIGITS[value & 0x0F];
+        value >>= 4;
+        digits++;
+    } while ((value != 0) || (digits < min_digits));
+    // Add prefix.
+    text[--idx] = 'x';
+    text[--idx] = '0';
+    return _print_tab(ctx, &text[idx], (AT_NUMBER_TEXT_SIZE - idx));
+}
+
+/*******************************************************************/
+static void _print_command_status(AT_context_t *ctx, AT_status_t at_status, int32_t error_code) {
+    // Local variables.
+    const char *error_text = NULL;
+    // Check verbose flag.
+    if (ctx->flags.field.verbose == 0) {
+        // Print status as numerical value.
+        _print_decimal(ctx, (int32_t) at_status);
+    } else if (((uint32_t) at_status < AT_ERROR_LAST) && (AT_STATUS_STRING[at_status] != NULL)) {
+        // Print status string.
+        _print(ctx, AT_STATUS_STRING[at_status]);
+        // Print error code.
+        switch (at_status) {
+        case AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_NUMBER:
+        case AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_PARSING:
+        case AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_VALUE:
+            _print_decimal(ctx, error_code);
+            break;
+        case AT_ERROR_EXTERNAL_COMMAND_CORE_ERROR:
+            if ((ctx->current_command != NULL) && (ctx->current_command->enum_to_str_callback != NULL)) {
+                error_text = ctx->current_command->enum_to_str_callback(error_code);
+            }
+            if (error_text != NULL) {
+                _print(ctx, error_text);
+            } else {
+                _print_hex(ctx, (uint32_t) error_code, 2);
+            }
+            break;
+        default:
+            break;
+        }
+    } else {
+        // Driver error.
+        _print(ctx, "ERROR:" AT_STATUS_UNKNOWN);
+        _print_decimal(ctx, (int32_t) at_status);
+    }
+    _end_line(ctx);
+#ifdef AT_METRICS
+    // A suspended status is counted once printed again entirely.
+    if (((uint32_t) at_status < AT_ERROR_LAST) && (_tx_is_suspended(ctx) == 0)) {
+        ctx->metrics.status_count[at_status]++;
+    }
+#endif
+    // Status is the end of the reply.
+    _tx_flush(ctx);
+}
+
+/*******************************************************************/
+static uint32_t _get_index_offset(AT_context_t *ctx, AT_command_type_t type) {
+    // Local variables.
+    uint32_t offset = 0;
+    uint32_t idx = 0;
+    // Index is sorted by type first, then by syntax.
+    for (idx = 0; idx < (uint32_t) type; idx++) {
+        offset += ctx->commands_count[idx];
+    }
+    return offset;
+}
+
+/*******************************************************************/
+static int _compare_key(const char *syntax, uint32_t syntax_size, const char *key, uint32_t key_size) {
+    // Local variables.
+    uint32_t compare_size = (syntax_size < key_size) ? syntax_size : key_size;
+    int result = memcmp(syntax, key, compare_size);
+    // Shorter string is lower when common part is equal.
+    if (result == 0) {
+        result = (syntax_size < key_size) ? -1 : ((syntax_size > key_size) ? 1 : 0);
+    }
+    return result;
+}
+
+/*******************************************************************/
+static int _compare_syntax(AT_context_t *ctx, AT_command_index_t slot, const char *key, uint32_t key_size) {
+    return _compare_key(ctx->commands_list[slot]->syntax, ctx->commands_syntax_size[slot], key, key_size);
+}
+
+/*******************************************************************/
+static uint32_t _get_common_size(const char *syntax, uint32_t syntax_size, const char *input, uint32_t input_size) {
+    // Local variables.
+    uint32_t common_size = 0;
+    while ((common_size < syntax_size) && (common_size < input_size) && (syntax[common_size] == input[common_size])) {
+        common_size++;
+    }
+    return common_size;
+}
+
+/*******************************************************************/
+static uint32_t _get_upper_bound(AT_context_t *ctx, uint32_t low, uint32_t high, const char *key, uint32_t key_size) {
+    // Local variables.
+    uint32_t middle = 0;
+    // Search first index whose syntax is strictly greater than the key.
+    while (low < high) {
+        middle = low + ((high - low) / 2);
+        if (_compare_syntax(ctx, ctx->commands_index[middle], key, key_size) <= 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+/*******************************************************************/
+static const AT_command_t *_search_command(AT_context_t *ctx, AT_command_type_t type, const char *input, uint32_t input_size, uint32_t *command_size, uint32_t *command_slot) {
+    // Local variables.
+    uint32_t low = _get_index_offset(ctx, type);
+    uint32_t high = low + ctx->commands_count[type];
+    uint32_t position = 0;
+    uint32_t syntax_size = 0;
+    uint32_t common_size = 0;
+    AT_command_index_t slot = 0;
+    // Longest prefix search.
+    // The greatest syntax lower or equal to the key is either the longest prefix of the key,
+    // or shares a common part with it: in this case, the longest prefix is shorter than this common part.
+    while (input_size > 0) {
+        position = _get_upper_bound(ctx, low, high, input, input_size);
+        if (position == low) {
+            break;
+        }
+        slot = ctx->commands_index[position - 1];
+        syntax_size = ctx->commands_syntax_size[slot];
+        common_size = _get_common_size(ctx->commands_list[slot]->syntax, syntax_size, input, input_size);
+        if (common_size == syntax_size) {
+            (*command_size) = syntax_size;
+            (*command_slot) = slot;
+            return ctx->commands_list[slot];
+        }
+        // Restrict search to the common part.
+        input_size = common_size;
+        high = position - 1;
+    }
+    return NULL;
+}
+
+/*******************************************************************/
+static uint32_t _get_table_upper_bound(const AT_command_table_t *table, uint32_t low, uint32_t high, const char *key, uint32_t key_size) {
+    // Local variables.
+    const char *syntax = NULL;
+    uint32_t middle = 0;
+    // Search first position whose syntax is strictly greater than the key.
+    while (low < high) {
+        middle = low + ((high - low) / 2);
+        syntax = table->commands[middle]->syntax;
+        if (_compare_key(syntax, strlen(syntax), key, key_size) <= 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+/*******************************************************************/
+static const AT_command_t *_search_table(const AT_command_table_t *table, AT_command_type_t type, const char *input, uint32_t input_size, uint32_t *command_size, uint32_t *command_position) {
+    // Local variables.
+    uint32_t low = table->type_offset[type];
+    uint32_t high = table->type_offset[type + 1];
+    uint32_t position = 0;
+    uint32_t syntax_size = 0;
+    uint32_t common_size = 0;
+    const AT_command_t *command = NULL;
+    // Same longest prefix search as in the index.
+    while (input_size > 0) {
+        position = _get_table_upper_bound(table, low, high, input, input_size);
+        if (position == low) {
+            break;
+        }
+        command = table->commands[position - 1];
+        syntax_size = strlen(command->syntax);
+        common_size = _get_common_size(command->syntax, syntax_size, input, input_size);
+        if (common_size == syntax_size) {
+            (*command_size) = syntax_size;
+            (*command_position) = position - 1;
+            return command;
+        }
+        // Restrict search to the common part.
+        input_size = common_size;
+        high = position - 1;
+    }
+    return NULL;
+}
+
+/*******************************************************************/
+static const AT_command_t *_get_command(AT_context_t *ctx, AT_rx_line_t *line, AT_command_type_t type, const char *input, uint32_t *command_size, uint32_t *command_slot) {
+    // Local variables.
+    const AT_command_t *command = NULL;
+    const AT_command_t *table_command = NULL;
+    uint32_t table_command_size = 0;
+    uint32_t table_position = 0;
+    uint32_t input_size = 0;
+    uint8_t search_flag = 1;
+    uint32_t idx = 0;
+#ifdef AT_INCREMENTAL_PARSING
+    // Use the command found during reception if the index did not change since.
+    if ((line != NULL) && ((line->parse_state == AT_PARSE_STATE_SYNTAX) || (line->parse_state == AT_PARSE_STATE_MATCH)) && (line->parse_generation == ctx->commands_generation)) {
+        if (line->parse_slot < AT_PARSE_NO_SLOT) {
+            (*command_size) = line->parse_size;
+            (*command_slot) = line->parse_slot;
+            command = ctx->commands_list[line->parse_slot];
+        }
+        search_flag = 0;
+    }
+#else
+    (void) line;
+#endif
+    if ((search_flag != 0) || (ctx->commands_tables_count > 0)) {
+        input_size = strlen(input);
+    }
+    if (search_flag != 0) {
+        command = _search_command(ctx, type, input, input_size, command_size, command_slot);
+    }
+    // Search the tables, a longer syntax is a better match.
+    for (idx = 0; idx < ctx->commands_tables_count; idx++) {
+        table_command = _search_table(&(ctx->commands_tables[idx]), type, input, input_size, &table_command_size, &table_position);
+        if ((table_command != NULL) && ((command == NULL) || (table_command_size > (*command_size)))) {
+            command = table_command;
+            (*command_size) = table_command_size;
+#if defined(AT_STATISTICS) || defined(AT_METRICS)
+            (*command_slot) = AT_TABLE_SLOT + ctx->commands_tables[idx].slot_offset + table_position;
+#else
+            (*command_slot) = AT_TABLE_SLOT;
+#endif
+        }
+    }
+    return command;
+}
+
+/*******************************************************************/
+static void _index_insert(AT_context_t *ctx, AT_command_index_t slot) {
+    // Local variables.
+    const AT_command_t *command = ctx->commands_list[slot];
+    uint32_t low = _get_index_offset(ctx, command->type);
+    uint32_t high = low + ctx->commands_count[command->type];
+    uint32_t total = _get_index_offset(ctx, AT_COMMAND_TYPE_LAST);
+    uint32_t position = 0;
+    // Cache syntax length.
+    ctx->commands_syntax_size[slot] = (AT_line_size_t) strlen(command->syntax);
+    // Insert slot in its type range.
+    position = _get_upper_bound(ctx, low, high, command->syntax, ctx->commands_syntax_size[slot]);
+    memmove(&ctx->commands_index[position + 1], &ctx->commands_index[position], ((total - position) * sizeof(AT_command_index_t)));
+    ctx->commands_index[position] = slot;
+    ctx->commands_count[command->type]++;
+}
+
+/*******************************************************************/
+static void _index_remove(AT_context_t *ctx, AT_command_index_t slot) {
+    // Local variables.
+    const AT_command_t *command = ctx->commands_list[slot];
+    uint32_t low = _get_index_offset(ctx, command->type);
+    uint32_t high = low + ctx->commands_count[command->type];
+    uint32_t total = _get_index_offset(ctx, AT_COMMAND_TYPE_LAST);
+    uint32_t position = 0;
+    // Search slot in its type range.
+    for (position = low; position < high; position++) {
+        if (ctx->commands_index[position] == slot) {
+            memmove(&ctx->commands_index[position], &ctx->commands_index[position + 1], ((total - position - 1) * sizeof(AT_command_index_t)));
+            ctx->commands_count[command->type]--;
+            break;
+        }
+    }
+}
+
+/*******************************************************************/
+static AT_status_t _parse_arguments(char *content, AT_argument_slice_t *arguments, uint32_t *argc, int32_t *error_code) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    char *start = NULL;
+    char separator = '\0';
+    uint8_t quoted = 0;
+    // Reset count.
+    (*argc) = 0;
+    // Empty content has no argument.
+    if ((*content) == '\0') {
+        goto errors;
+    }
+    // Single pass in place tokenizer: each argument is null terminated and returned as a slice.
+    while (1) {
+        // Check bound.
+        if ((*argc) >= AT_COMMAND_PARAMETER_MAX_NUMBER) {
+            (*error_code) = AT_COMMAND_PARAMETER_MAX_NUMBER;
+            status = AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_NUMBER;
+            goto errors;
+        }
+        quoted = ((*content) == AT_COMMAND_PARAMETER_QUOTE) ? 1 : 0;
+        if (quoted != 0) {
+            // String argument: separators are allowed between quotes.
+            start = ++content;
+            while (((*content) != AT_COMMAND_PARAMETER_QUOTE) && ((*content) != '\0')) {
+                content++;
+            }
+            if ((*content) == '\0') {
+                (*error_code) = (int32_t) (*argc);
+                status = AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_PARSING;
+                goto errors;
+            }
+            (*content) = '\0';
+            content++;
+            if (((*content) != AT_COMMAND_PARAMETER_SEPARATOR) && ((*content) != '\0')) {
+                (*error_code) = (int32_t) (*argc);
+                status = AT_ERROR_EXTERNAL_COMMAND_BAD_PARAMETER_PARSING;
+                goto errors;
+            }
+            arguments[*argc].data = start;
+            arguments[*argc].size = (uint32_t) (content - start - 1);
+        } else {
+            start = content;
+            while (((*content) != AT_COMMAND_PARAMETER_SEPARATOR) && ((*content) != '\0')) {
+                content++;
+            }
+            // Empty arguments are given as NULL pointers.
+            arguments[*argc].data = (content == start) ? NULL : start;
+            arguments[*argc].size = (uint32_t) (content - start);
+        }
+        (*argc)++;
+        // Terminate argument.
+        separator = (*content);
+        if (separator == '\0') {
+            break;
+        }
+        (*content) = '\0';
+        content++;
+        // A trailing separator does not add an empty argument.
+        if ((*content) == '\0') {
+            break;
+        }
+    }
+errors:
+    return status;
+}
+
+#ifdef AT_READ_CACHE
+/*******************************************************************/
+static uint8_t _read_cache_enabled(const AT_command_t *command) {
+    // Replies of the jobs are not printed by the callback.
+#ifdef AT_WORKER
+    if (at_current_job != NULL) {
+        return 0;
+    }
+#endif
+    return (command->cache_ttl != 0) ? 1 : 0;
+}
+
+/*******************************************************************/
+static AT_read_cache_t *_read_cache_search(AT_context_t *ctx, const AT_command_t *command) {
+    // Local variables.
+    uint32_t idx = 0;
+    // Search the entry of the command.
+    for (idx = 0; idx < AT_READ_CACHE_NUMBER; idx++) {
+        if (ctx->read_cache[idx].command == command) {
+            return &(ctx->read_cache[idx]);
+        }
+    }
+    return NULL;
+}
+
+/*******************************************************************/
+static uint8_t _read_cache_replay(AT_context_t *ctx, const AT_command_t *command) {
+    // Local variables.
+    AT_read_cache_t *entry = NULL;
+    // Check cache.
+    if (_read_cache_enabled(command) == 0) {
+        return 0;
+    }
+    entry = _read_cache_search(ctx, command);
+    if ((entry == NULL) || (entry->valid == 0)) {
+        return 0;
+    }
+    if ((uint32_t) (_get_timestamp(ctx) - entry->timestamp) >= command->cache_ttl) {
+        entry->valid = 0;
+        return 0;
+    }
+    // The callback is executed when the replies can not be written at once.
+    if (_tx_check(ctx, entry->size, 0) != AT_SUCCESS) {
+        return 0;
+    }
+    // Print the replies of the last read.
+    _print_tab(ctx, entry->buffer, entry->size);
+    return 1;
+}
+
+/*******************************************************************/
+static void _read_cache_start(AT_context_t *ctx, const AT_command_t *command) {
+    // Local variables.
+    AT_read_cache_t *entry = NULL;
+    AT_read_cache_t *candidate = NULL;
+    uint32_t timestamp = 0;
+    uint32_t age = 0;
+    uint32_t oldest_age = 0;
+    uint32_t idx = 0;
+    // Nothing is printed in quiet mode.
+    if ((_read_cache_enabled(command) == 0) || (ctx->flags.field.quiet != 0)) {
+        return;
+    }
+    timestamp = _get_timestamp(ctx);
+    // Use the entry of the command, otherwise an invalid entry or the oldest one.
+    entry = _read_cache_search(ctx, command);
+    if (entry == NULL) {
+        for (idx = 0; idx < AT_READ_CACHE_NUMBER; idx++) {
+            candidate = &(ctx->read_cache[idx]);
+            age = (candidate->valid == 0) ? 0xFFFFFFFF : ((uint32_t) (timestamp - candidate->timestamp));
+            if ((entry == NULL) || (age > oldest_age)) {
+                entry = candidate;
+                oldest_age = age;
+            }
+        }
+    }
+    // Start capture.
+    entry->valid = 0;
+    entry->command = command;
+    entry->timestamp = timestamp;
+    entry->size = 0;
+    ctx->read_cache_overflow = 0;
+    ctx->read_cache_capture_generation = ctx->read_cache_generation;
+    ctx->read_cache_capture = entry;
+}
+
+/*******************************************************************/
+static void _read_cache_end(AT_context_t *ctx, AT_status_t status) {
+    // Local variables.
+    AT_read_cache_t *entry = ctx->read_cache_capture;
+    // Check capture.
+    if (entry == NULL) {
+        return;
+    }
+    ctx->read_cache_capture = NULL;
+    // Keep only complete replies of successful reads, not invalidated meanwhile.
+    if ((status == AT_SUCCESS) && (ctx->read_cache_overflow == 0) && (ctx->read_cache_capture_generation == ctx->read_cache_generation)) {
+        AT_MEMORY_BARRIER();
+        entry->valid = 1;
+    }
+}
+
+/*******************************************************************/
+static void _read_cache_invalidate(AT_context_t *ctx, const AT_command_t *command) {
+    // Local variables.
+    uint32_t idx = 0;
+    // Abort the current capture.
+    ctx->read_cache_generation++;
+    for (idx = 0; idx < AT_READ_CACHE_NUMBER; idx++) {
+        if ((command == NULL) || (ctx->read_cache[idx].command == command)) {
+            ctx->read_cache[idx].valid = 0;
+        }
+    }
+}
+#endif
+
+/*******************************************************************/
+static AT_status_t _call_command(AT_context_t *ctx, const AT_command_t *command, char *input_command, uint32_t command_size, AT_command_type_t type, int32_t *command_return_code) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    char *content = input_command;
+    AT_argument_slice_t command_arguments[AT_COMMAND_PARAMETER_MAX_NUMBER];
+    AT_argument_t command_typed_arguments[AT_COMMAND_PARAMETER_MAX_NUMBER];
+    char *command_argv[AT_COMMAND_PARAMETER_MAX_NUMBER] = {NULL};
+    uint32_t command_argc = 0;
+    uint32_t idx = 0;
+    // Check command help.
+    if ((input_command[command_size] == AT_COMMAND_MARKER_WRITE) && (input_command[command_size + 1] == AT_COMMAND_MARKER_READ_HELP) && (input_command[command_size + 2] == AT_COMMAND_MARKER_EXECUTION)) {
+#ifdef AT_NO_HELP
+        (void) ctx;
+        status = AT_ERROR_INTERNAL_COMMAND_PARSING;
+        goto errors;
+#else
+        // The help is printed again once the TX buffer is empty when it does not fit.
+        _tx_begin_unit(ctx, AT_TX_UNIT_COMMAND);
+        status = _print_command_help(ctx, command);
+        status = _tx_end_unit(ctx, status);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+#endif
+    } else if (input_command[command_size] == AT_COMMAND_MARKER_EXECUTION) {
+        // Check if read command exists.
+        if ((command->execution_callback) == NULL) {
+            status = AT_ERROR_INTERNAL_COMMAND_EXECUTION_NOT_DEFINED;
+            goto errors;
+        }
+        // Execute command.
+        status = command->execution_callback(command_return_code);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+    } else if (input_command[command_size] == AT_COMMAND_MARKER_READ_HELP) {
+        // Check if read command exists.
+        if ((command->read_callback) == NULL) {
+            status = AT_ERROR_INTERNAL_COMMAND_READ_NOT_DEFINED;
+            goto errors;
+        }
+#ifdef AT_READ_CACHE
+        // Replay the replies of the last read while they are valid.
+        if (_read_cache_replay(ctx, command) != 0) {
+            return AT_SUCCESS;
+        }
+        _read_cache_start(ctx, command);
+#endif
+        // Execute command.
+        status = command->read_callback(command_return_code);
+#ifdef AT_READ_CACHE
+        _read_cache_end(ctx, status);
+#endif
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+    } else if ((input_command[command_size] == AT_COMMAND_MARKER_WRITE) || (type == AT_COMMAND_TYPE_BASIC)) {
+        // Check if write command exists.
+        if (((command->write_callback) == NULL) && ((command->typed_write_callback) == NULL)) {
+            status = AT_ERROR_INTERNAL_COMMAND_WRITE_NOT_DEFINED;
+            goto errors;
+        }
+        if (type == AT_COMMAND_TYPE_BASIC) {
+            content = &input_command[command_size];
+        } else {
+            content = &input_command[command_size + 1];
+        }
+        // Parse parameters.
+        status = _parse_arguments(content, command_arguments, &command_argc, command_return_code);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+        // Typed arguments.
+        if ((command->typed_write_callback) != NULL) {
+            status = _convert_arguments(command->write_schema, command_arguments, command_argc, command_typed_arguments, 1, command_return_code);
+            if (status != AT_SUCCESS) {
+                goto errors;
+            }
+            // Execute command.
+            status = command->typed_write_callback(command_argc, command_typed_arguments, command_return_code);
+            if (status != AT_SUCCESS) {
+                goto errors;
+            }
+        } else {
+            // Check arguments without converting them, so that the callback receives the original strings.
+            if ((command->write_schema) != NULL) {
+                status = _convert_arguments(command->write_schema, command_arguments, command_argc, command_typed_arguments, 0, command_return_code);
+                if (status != AT_SUCCESS) {
+                    goto errors;
+                }
+            }
+            for (idx = 0; idx < command_argc; idx++) {
+                command_argv[idx] = command_arguments[idx].data;
+            }
+            // Execute command.
+            status = command->write_callback(command_argc, command_argv, command_return_code);
+            if (status != AT_SUCCESS) {
+                goto errors;
+            }
+        }
+    } else {
+        status = AT_ERROR_INTERNAL_COMMAND_MARKER_NOT_DEFINED;
+        goto errors;
+    }
+    return AT_SUCCESS;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _parse_and_execute_command(AT_context_t *ctx, AT_rx_line_t *line, char *input_command, AT_command_type_t type, int32_t *command_return_code) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    uint32_t command_size = 0;
+    uint32_t command_slot = 0;
+#ifdef AT_STATISTICS
+    uint32_t timestamp = _get_timestamp(ctx);
+#endif
+    // Search longest matching command in index.
+    ctx->current_command = _get_command(ctx, line, type, input_command, &command_size, &command_slot);
+    if (ctx->current_command == NULL) {
+        status = AT_ERROR_INTERNAL_COMMAND_NOT_FOUND;
+        goto errors;
+    }
+#ifdef AT_STATISTICS
+    ctx->statistics_slot = command_slot;
+    ctx->statistics_timings[AT_STATISTICS_PHASE_LOOKUP] = _get_timestamp(ctx) - timestamp;
+    timestamp += ctx->statistics_timings[AT_STATISTICS_PHASE_LOOKUP];
+#endif
+#ifdef AT_METRICS
+    // A command executed again to resume its output is counted once.
+    if (_tx_get_unit(ctx) != AT_TX_UNIT_COMMAND) {
+        _metrics_hit(ctx, command_slot);
+    }
+#endif
+#if !defined(AT_STATISTICS) && !defined(AT_METRICS)
+    (void) command_slot;
+#endif
+    // Check marker and execute callback.
+    status = _call_command(ctx, ctx->current_command, input_command, command_size, type, command_return_code);
+#ifdef AT_STATISTICS
+    ctx->statistics_timings[AT_STATISTICS_PHASE_CALLBACK] = _get_timestamp(ctx) - timestamp;
+#endif
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    return AT_SUCCESS;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static char *_get_separator(char *command) {
+    // Local variables.
+    uint8_t quoted = 0;
+    // Search separator outside of quoted strings.
+    while ((*command) != '\0') {
+        if ((*command) == AT_COMMAND_PARAMETER_QUOTE) {
+            quoted ^= 1;
+        } else if (((*command) == AT_COMMAND_SEPARATOR) && (quoted == 0)) {
+            return command;
+        }
+        command++;
+    }
+    return NULL;
+}
+
+/*******************************************************************/
+static char *_split_command(char *command) {
+    // Local variables.
+    char *separator = _get_separator(command);
+    // Terminate the command and return the next one.
+    if (separator == NULL) {
+        return NULL;
+    }
+    (*separator) = '\0';
+    return (separator + 1);
+}
+
+/*******************************************************************/
+static AT_status_t _execute_command(AT_context_t *ctx, AT_rx_line_t *line, char *command, int32_t *command_return_code) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    // Check marker.
+    switch (command[0]) {
+    case AT_COMMAND_MARKER_EXECUTION: // Ping commands AT.
+        break;
+    case AT_COMMAND_MARKER_READ_HELP: // Help is only allowed alone.
+        status = AT_ERROR_INTERNAL_COMMAND_PARSING;
+        break;
+    case AT_COMMAND_HEADER_EXTENDED: // Extended commands AT$.
+        status = _parse_and_execute_command(ctx, line, &command[1], AT_COMMAND_TYPE_EXTENDED, command_return_code);
+        break;
+    case AT_COMMAND_HEADER_DEBUG: // Debug commands AT!.
+        status = _parse_and_execute_command(ctx, line, &command[1], AT_COMMAND_TYPE_DEBUG, command_return_code);
+        break;
+    default: // Basic command AT.
+        status = _parse_and_execute_command(ctx, line, command, AT_COMMAND_TYPE_BASIC, command_return_code);
+        break;
+    }
+    return status;
+}
+
+/*******************************************************************/
+static uint8_t _end_command(AT_context_t *ctx, const AT_command_t *command, AT_status_t command_status, int32_t return_code) {
+    // Keep the first error of the line.
+    if (command_status == AT_SUCCESS) {
+        return 0;
+    }
+    if (ctx->line_status == AT_SUCCESS) {
+        ctx->line_status = command_status;
+        ctx->line_error_code = return_code;
+        ctx->line_error_command = command;
+    }
+    // Check if the next commands of the line are executed.
+    return ctx->flags.field.stop_on_error;
+}
+
+/*******************************************************************/
+static AT_status_t _execute_line(AT_context_t *ctx, AT_rx_line_t *line, char *commands, int32_t *command_return_code) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    int32_t return_code = 0;
+    char *command = commands;
+    char *next_command = NULL;
+    // Execute concatenated commands in order (AT$A=1;$B=2;E0), the first error is returned.
+    while (command != NULL) {
+#ifdef AT_STATISTICS
+        // The status is printed after the last command of the line only.
+        ctx->statistics_timings[AT_STATISTICS_PHASE_PRINT] = 0;
+        _statistics_update(ctx);
+#endif
+        // Each command starts with an empty TX buffer, so that its replies are not rejected by the previous output.
+        if (_tx_wait(ctx) != 0) {
+            ctx->pending_state = AT_PENDING_STATE_TX;
+            ctx->pending_next_command = command;
+            status = AT_PENDING;
+            goto errors;
+        }
+        next_command = _split_command(command);
+        return_code = 0;
+        status = _execute_command(ctx, line, command, &return_code);
+        // The search done during reception only applies to the first command.
+        line = NULL;
+        // Output suspended: the command is executed again once the TX buffer is empty.
+        if ((status == AT_PENDING) && (_tx_get_unit(ctx) == AT_TX_UNIT_COMMAND)) {
+            if (next_command != NULL) {
+                (*(next_command - 1)) = AT_COMMAND_SEPARATOR;
+            }
+#ifdef AT_STATISTICS
+            ctx->statistics_slot = AT_STATISTICS_NO_SLOT;
+#endif
+            ctx->pending_state = AT_PENDING_STATE_TX;
+            ctx->pending_next_command = command;
+            goto errors;
+        }
+        if (status == AT_PENDING) {
+            // Wait for AT_complete(), unless it was already called by the callback.
+            if (ctx->pending_state != AT_PENDING_STATE_COMPLETE) {
+                ctx->pending_state = AT_PENDING_STATE_WAITING;
+                ctx->pending_command = ctx->current_command;
+                ctx->pending_next_command = next_command;
+                goto errors;
+            }
+            status = ctx->pending_status;
+            return_code = ctx->pending_error_code;
+        }
+        ctx->pending_state = AT_PENDING_STATE_IDLE;
+        if (_end_command(ctx, ctx->current_command, status, return_code) != 0) {
+            break;
+        }
+        command = next_command;
+    }
+    // Keep the failed command for the status print.
+    status = ctx->line_status;
+    if (status != AT_SUCCESS) {
+        (*command_return_code) = ctx->line_error_code;
+        ctx->current_command = ctx->line_error_command;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _resume_line(AT_context_t *ctx, int32_t *command_return_code) {
+    // Local variables.
+    char *next_command = ctx->pending_next_command;
+    // Continue the line once the TX buffer is empty.
+    if (ctx->pending_state == AT_PENDING_STATE_TX) {
+        ctx->pending_state = AT_PENDING_STATE_IDLE;
+        return _execute_line(ctx, NULL, next_command, command_return_code);
+    }
+    // End pending command and continue the line.
+    ctx->pending_state = AT_PENDING_STATE_IDLE;
+    ctx->current_command = ctx->pending_command;
+    if (_end_command(ctx, ctx->pending_command, ctx->pending_status, ctx->pending_error_code) != 0) {
+        next_command = NULL;
+    }
+    return _execute_line(ctx, NULL, next_command, command_return_code);
+}
+
+#ifdef AT_WORKER
+/*******************************************************************/
+static const AT_command_t *_get_job_command(AT_context_t *ctx, AT_rx_line_t *line) {
+    // Local variables.
+    const AT_command_t *command = NULL;
+    char *rx_buffer = line->buffer;
+    uint32_t command_start_idx = (sizeof(AT_HEADER) - 1);
+    uint32_t command_size = 0;
+    uint32_t command_slot = 0;
+    AT_command_type_t type = AT_COMMAND_TYPE_BASIC;
+    // Errors are printed by AT_process().
+    if (line->overflow != 0) {
+        goto errors;
+    }
+#ifdef AT_INCREMENTAL_PARSING
+    if (line->parse_state == AT_PARSE_STATE_REJECTED) {
+        goto errors;
+    }
+#endif
+    if (memcmp((uint8_t *) rx_buffer, AT_HEADER, command_start_idx) != 0) {
+        goto errors;
+    }
+    // Only lines made of a single command are executed by a worker (not AT, AT? or concatenated commands).
+    if ((rx_buffer[command_start_idx] == AT_COMMAND_MARKER_EXECUTION) || (rx_buffer[command_start_idx] == AT_COMMAND_MARKER_READ_HELP) || (_get_separator(&rx_buffer[command_start_idx]) != NULL)) {
+        goto errors;
+    }
+    if (rx_buffer[command_start_idx] == AT_COMMAND_HEADER_EXTENDED) {
+        type = AT_COMMAND_TYPE_EXTENDED;
+        command_start_idx++;
+    } else if (rx_buffer[command_start_idx] == AT_COMMAND_HEADER_DEBUG) {
+        type = AT_COMMAND_TYPE_DEBUG;
+        command_start_idx++;
+    }
+    command = _get_command(ctx, line, type, &rx_buffer[command_start_idx], &command_size, &command_slot);
+    if ((command == NULL) || (command->mode == AT_COMMAND_MODE_INLINE)) {
+        goto errors;
+    }
+    // Command help is printed by AT_process().
+    if ((rx_buffer[command_start_idx + command_size] == AT_COMMAND_MARKER_WRITE) && (rx_buffer[command_start_idx + command_size + 1] == AT_COMMAND_MARKER_READ_HELP)) {
+        goto errors;
+    }
+#ifdef AT_METRICS
+    _metrics_hit(ctx, command_slot);
+#endif
+    line->job_command = command;
+    line->job_type = (uint8_t) type;
+    line->job_start = (AT_line_size_t) command_start_idx;
+    line->job_command_size = (AT_line_size_t) command_size;
+    return command;
+errors:
+    return NULL;
+}
+
+/*******************************************************************/
+static void _dispatch_jobs(AT_context_t *ctx) {
+    // Local variables.
+    AT_rx_line_t *line = NULL;
+    uint8_t read_count = ctx->rx_read_count;
+    uint8_t write_count = ctx->rx_write_count;
+    uint8_t idx = 0;
+    uint32_t busy_mask = 0;
+    uint32_t resource_mask = 0;
+    uint8_t queued_flag = 0;
+    AT_MEMORY_BARRIER();
+    // Resources used by the jobs already given to the workers.
+    for (idx = read_count; idx != write_count; idx++) {
+        line = &ctx->rx_lines[idx % AT_RX_LINES_NUMBER];
+        if (((line->job_state == AT_JOB_STATE_QUEUED) || (line->job_state == AT_JOB_STATE_RUNNING)) && (line->job_command->mode == AT_COMMAND_MODE_WORKER)) {
+            busy_mask |= AT_WORKER_RESOURCE_MASK(line->job_command);
+        }
+    }
+    // Queue the jobs received before the next inline line.
+    for (idx = read_count; idx != write_count; idx++) {
+        line = &ctx->rx_lines[idx % AT_RX_LINES_NUMBER];
+        if (line->job_state == AT_JOB_STATE_UNKNOWN) {
+            line->job_state = (_get_job_command(ctx, line) != NULL) ? AT_JOB_STATE_WAITING : AT_JOB_STATE_INLINE;
+        }
+        if (line->job_state == AT_JOB_STATE_INLINE) {
+            break;
+        }
+        if (line->job_state != AT_JOB_STATE_WAITING) {
+            continue;
+        }
+        // Keep the reception order of the jobs using the same resource.
+        if (line->job_command->mode == AT_COMMAND_MODE_WORKER) {
+            resource_mask = AT_WORKER_RESOURCE_MASK(line->job_command);
+            if ((busy_mask & resource_mask) != 0) {
+                continue;
+            }
+            busy_mask |= resource_mask;
+        }
+        AT_MEMORY_BARRIER();
+        line->job_state = AT_JOB_STATE_QUEUED;
+        queued_flag = 1;
+    }
+    // Wake up the workers.
+    if ((queued_flag != 0) && (ctx->worker_callback != NULL)) {
+        ctx->worker_callback();
+    }
+}
+
+/*******************************************************************/
+static void _print_job(AT_context_t *ctx, AT_rx_line_t *line) {
+    // Echo is printed with the replies, in the reception order.
+    if (ctx->flags.field.echo != 0) {
+        _print_line(ctx, line->buffer);
+    }
+    _print_tab(ctx, line->job_reply, line->job_reply_size);
+    ctx->current_command = line->job_command;
+    _print_command_status(ctx, line->job_status, line->job_error_code);
+}
+
+/*******************************************************************/
+static uint8_t _process_jobs(AT_context_t *ctx) {
+    // Local variables.
+    AT_rx_line_t *line = NULL;
+    // The current line is not finished yet.
+    if (ctx->pending_state != AT_PENDING_STATE_IDLE) {
+        return 1;
+    }
+    if ((_tx_get_unit(ctx) != AT_TX_UNIT_NONE) && (_tx_get_unit(ctx) != AT_TX_UNIT_JOB)) {
+        return 1;
+    }
+#ifndef AT_NO_HELP
+    if (ctx->help_flag != 0) {
+        return 1;
+    }
+#endif
+    // Print the jobs done, until a job still executing or an inline line.
+    while (ctx->rx_read_count != ctx->rx_write_count) {
+        _dispatch_jobs(ctx);
+        line = &ctx->rx_lines[ctx->rx_read_count % AT_RX_LINES_NUMBER];
+        if (line->job_state == AT_JOB_STATE_INLINE) {
+            return 1;
+        }
+        if (line->job_state != AT_JOB_STATE_DONE) {
+            break;
+        }
+        AT_MEMORY_BARRIER();
+        _tx_begin_unit(ctx, AT_TX_UNIT_JOB);
+        _print_job(ctx, line);
+        // The job is printed again once the TX buffer is empty.
+        if (_tx_end_unit(ctx, AT_SUCCESS) == AT_PENDING) {
+            _tx_suspend(ctx);
+            break;
+        }
+        _rx_release_line(ctx, line);
+    }
+    return 0;
+}
+
+/*******************************************************************/
+static char *_job_reply_reserve(AT_rx_line_t *line, const AT_command_t *command, uint32_t size) {
+    // Local variables.
+    char *buffer = &(line->job_reply[line->job_reply_size]);
+    uint32_t syntax_size = 0;
+    // The reply is kept only if it fits entirely.
+    if (((uint32_t) line->job_reply_size + _get_reply_header_size(command) + size + (sizeof(AT_REPLY_END) - 1)) > AT_WORKER_REPLY_SIZE) {
+        return NULL;
+    }
+    // Write header.
+    if (command != NULL) {
+        if (AT_COMMAND_HEADER[command->type] != '\0') {
+            (*buffer++) = AT_COMMAND_HEADER[command->type];
+        }
+        syntax_size = strlen(command->syntax);
+        memcpy(buffer, command->syntax, syntax_size);
+        buffer += syntax_size;
+        (*buffer++) = ':';
+    }
+    line->job_reply_size = (uint16_t) (buffer - line->job_reply);
+    return buffer;
+}
+
+/*******************************************************************/
+static void _job_reply_commit(AT_rx_line_t *line, uint32_t size) {
+    // Reply was written after the header.
+    memcpy(&(line->job_reply[line->job_reply_size + size]), AT_REPLY_END, (sizeof(AT_REPLY_END) - 1));
+    line->job_reply_size = (uint16_t) (line->job_reply_size + size + (sizeof(AT_REPLY_END) - 1));
+}
+#endif
+
+#ifdef AT_URC
+/*******************************************************************/
+static AT_status_t _print_urc(AT_context_t *ctx) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_urc_t *urc = NULL;
+    uint8_t print_flag = 0;
+    // Codes are not printed in the middle of another suspended output.
+    if ((_tx_get_unit(ctx) != AT_TX_UNIT_NONE) && (_tx_get_unit(ctx) != AT_TX_UNIT_URC)) {
+        goto errors;
+    }
+    // Print posted codes in order, until a slot which is still being written.
+    while (ctx->urc_read_count != ctx->urc_write_count) {
+        urc = &ctx->urc[ctx->urc_read_count % AT_URC_NUMBER];
+        if (urc->ready == 0) {
+            break;
+        }
+        AT_MEMORY_BARRIER();
+        _tx_begin_unit(ctx, AT_TX_UNIT_URC);
+        _print_line(ctx, urc->buffer);
+        // The code is printed again once the TX buffer is empty.
+        status = _tx_end_unit(ctx, AT_SUCCESS);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+        urc->ready = 0;
+        // Release slot.
+        AT_MEMORY_BARRIER();
+        ctx->urc_read_count++;
+        print_flag = 1;
+    }
+    if (print_flag != 0) {
+        _tx_flush(ctx);
+    }
+errors:
+    return status;
+}
+#endif
+
+#ifdef AT_DATA_MODE
+/*******************************************************************/
+static AT_status_t _process_data(AT_context_t *ctx) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_context_t *previous_ctx = at_current_ctx;
+    int32_t error_code = 0;
+    // Continue the status print of the frame, kept in the line status fields.
+    if (_tx_get_unit(ctx) == AT_TX_UNIT_DATA) {
+        status = ctx->line_status;
+        error_code = ctx->line_error_code;
+        goto print;
+    }
+    // Check end of frame or timeout.
+    if (ctx->data_state == AT_DATA_STATE_COMPLETE) {
+        status = (ctx->data_received_crc == ctx->data_crc) ? AT_SUCCESS : AT_ERROR_INTERNAL_DATA_CRC;
+    } else if ((ctx->data_config.timeout != 0) && ((uint32_t) (_get_timestamp(ctx) - ctx->data_timestamp) > ctx->data_config.timeout)) {
+        status = AT_ERROR_INTERNAL_DATA_TIMEOUT;
+    } else {
+        goto errors;
+    }
+    // Back to text mode.
+    ctx->data_state = AT_DATA_STATE_IDLE;
+    // Give reception status to the user.
+    ctx->flags.field.running = 1;
+    ctx->current_command = NULL;
+    at_current_ctx = ctx;
+    status = ctx->data_config.end_callback(status, &error_code);
+    ctx->line_status = status;
+    ctx->line_error_code = error_code;
+print:
+    ctx->flags.field.running = 1;
+    at_current_ctx = ctx;
+    _tx_begin_unit(ctx, AT_TX_UNIT_DATA);
+    _print_command_status(ctx, status, error_code);
+    ctx->flags.field.running = 0;
+    at_current_ctx = previous_ctx;
+    // The status is printed again once the TX buffer is empty.
+    if (_tx_end_unit(ctx, AT_SUCCESS) == AT_PENDING) {
+        _tx_suspend(ctx);
+        status = AT_SUCCESS;
+        goto errors;
+    }
+    // Ask for processing of the lines received after the frame.
+    if ((ctx->rx_read_count != ctx->rx_write_count) && (ctx->process_callback != NULL)) {
+        ctx->process_callback();
+    }
+errors:
+    return status;
+}
+#endif
+
+/*******************************************************************/
+AT_status_t _print_command_header(AT_context_t *ctx, AT_command_type_t type) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    char header[2] = {0x00};
+    // Check type.
+    if (type >= AT_COMMAND_TYPE_LAST) {
+        status = AT_ERROR_COMMAND_TYPE;
+        goto errors;
+    }
+    header[0] = AT_COMMAND_HEADER[type];
+    status = _print(ctx, header);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _print_reply_header(AT_context_t *ctx, const AT_command_t *command) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    // Replies without command have no header.
+    if (command == NULL) {
+        goto errors;
+    }
+    status = _print_command_header(ctx, command->type);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    status = _print(ctx, command->syntax);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    status = _print(ctx, ":");
+errors:
+    return status;
+}
+
+#ifndef AT_NO_HELP
+/*******************************************************************/
+static AT_status_t _print_help_text(AT_context_t *ctx, const char *text) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+#ifdef AT_HELP_COMPRESSED
+    const char *run = text;
+    uint8_t token = 0;
+    // Print the literal runs and expand the dictionary words on the fly.
+    while ((*text) != '\0') {
+        if ((((uint8_t) (*text)) & AT_HELP_TOKEN) == 0) {
+            text++;
+            continue;
+        }
+        if (text != run) {
+            status = _print_tab(ctx, (char *) run, (uint32_t) (text - run));
+            if (status != AT_SUCCESS) {
+                goto errors;
+            }
+        }
+        token = (uint8_t) (((uint8_t) (*text)) - AT_HELP_TOKEN);
+        if (token < AT_HELP_DICTIONARY_SIZE) {
+            status = _print(ctx, AT_HELP_DICTIONARY[token]);
+            if (status != AT_SUCCESS) {
+                goto errors;
+            }
+        }
+        text++;
+        run = text;
+    }
+    if (text != run) {
+        status = _print_tab(ctx, (char *) run, (uint32_t) (text - run));
+    }
+errors:
+#else
+    status = _print(ctx, text);
+#endif
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _print_help_line(AT_context_t *ctx, const AT_command_t *command, AT_help_line_t line) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    const char *help = NULL;
+    char marker[2] = {0x00};
+    const char *arguments = NULL;
+    // Select line.
+    switch (line) {
+    case AT_HELP_LINE_COMMAND:
+        // Print common syntax.
+        status = _print(ctx, "    ");
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+        status = _print(ctx, command->syntax);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+        status = _print(ctx, " : ");
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+        status = _print_help_text(ctx, command->help);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+        status = _end_line(ctx);
+        goto errors;
+    case AT_HELP_LINE_EXECUTION:
+        if ((command->execution_callback) == NULL) {
+            goto errors;
+        }
+        help = command->execution_help;
+        break;
+    case AT_HELP_LINE_WRITE:
+        if (((command->write_callback) == NULL) && ((command->typed_write_callback) == NULL)) {
+            goto errors;
+        }
+        if ((command->type) != AT_COMMAND_TYPE_BASIC) {
+            marker[0] = AT_COMMAND_MARKER_WRITE;
+        }
+        arguments = command->write_arguments;
+        help = command->write_help;
+        break;
+    case AT_HELP_LINE_READ:
+        if ((command->read_callback) == NULL) {
+            goto errors;
+        }
+        marker[0] = AT_COMMAND_MARKER_READ_HELP;
+        help = command->read_help;
+        break;
+    default:
+        goto errors;
+    }
+    // Print command usage.
+    status = _print(ctx, AT_COMMAND_HEADER_HELP);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    status = _print(ctx, AT_HEADER);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    status = _print_command_header(ctx, command->type);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    status = _print(ctx, command->syntax);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    status = _print(ctx, marker);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    if (arguments != NULL) {
+        status = _print_help_text(ctx, arguments);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+    }
+    status = _print(ctx, " : ");
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    status = _print_help_text(ctx, help);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    status = _end_line(ctx);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _print_command_help(AT_context_t *ctx, const AT_command_t *command) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    uint32_t line = 0;
+    // Print all lines of the command.
+    for (line = AT_HELP_LINE_COMMAND; line < AT_HELP_LINE_LAST; line++) {
+        status = _print_help_line(ctx, command, (AT_help_line_t) line);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static void _start_help(AT_context_t *ctx) {
+    // Reset cursor.
+    ctx->help_flag = 1;
+    ctx->help_type = AT_COMMAND_TYPE_BASIC;
+    ctx->help_table = 0;
+    ctx->help_slot = 0;
+    ctx->help_line = AT_HELP_LINE_TYPE;
+}
+
+/*******************************************************************/
+static uint32_t _get_type_count(AT_context_t *ctx, uint8_t type) {
+    // Local variables.
+    uint32_t count = ctx->commands_count[type];
+    uint32_t idx = 0;
+    // Add commands of the tables.
+    for (idx = 0; idx < ctx->commands_tables_count; idx++) {
+        count += (uint32_t) (ctx->commands_tables[idx].type_offset[type + 1] - ctx->commands_tables[idx].type_offset[type]);
+    }
+    return count;
+}
+
+/*******************************************************************/
+static AT_status_t _print_help(AT_context_t *ctx) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    const AT_command_t *command = NULL;
+    const AT_command_table_t *table = NULL;
+    uint32_t lines_count = 0;
+    // Print at most AT_HELP_LINES_PER_PROCESS lines, then return to the application.
+    // A line which does not fit in the TX buffer is printed again once it is empty, the cursor only moves after it.
+    while (lines_count < AT_HELP_LINES_PER_PROCESS) {
+        // Check end of help.
+        if ((ctx->help_type) >= AT_COMMAND_TYPE_LAST) {
+            ctx->help_flag = 0;
+            break;
+        }
+        // Type title.
+        if ((ctx->help_line) == AT_HELP_LINE_TYPE) {
+            _tx_begin_unit(ctx, AT_TX_UNIT_HELP);
+            status = _print_line(ctx, AT_HELP_TYPE_TITLE[ctx->help_type]);
+            if ((status == AT_SUCCESS) && (_get_type_count(ctx, ctx->help_type) == 0)) {
+                status = _print_line(ctx, "    None");
+            }
+            status = _tx_end_unit(ctx, status);
+            if (status != AT_SUCCESS) {
+                goto errors;
+            }
+            // The tables are printed first (built-in commands table is the first one), then the list (help_table is the tables count).
+            ctx->help_table = 0;
+            ctx->help_slot = ((ctx->commands_tables_count) > 0) ? ctx->commands_tables[0].type_offset[ctx->help_type] : 0;
+            if (_get_type_count(ctx, ctx->help_type) == 0) {
+                ctx->help_table = ctx->commands_tables_count;
+                ctx->help_slot = AT_COMMAND_LIST_SIZE;
+            }
+            ctx->help_line = AT_HELP_LINE_COMMAND;
+            lines_count++;
+            continue;
+        }
+        // Check end of table.
+        table = ((ctx->help_table) < (ctx->commands_tables_count)) ? &(ctx->commands_tables[ctx->help_table]) : NULL;
+        if ((table != NULL) && ((ctx->help_slot) >= table->type_offset[ctx->help_type + 1])) {
+            ctx->help_table++;
+            ctx->help_slot = ((ctx->help_table) < (ctx->commands_tables_count)) ? ctx->commands_tables[ctx->help_table].type_offset[ctx->help_type] : 0;
+            continue;
+        }
+        // Check end of type.
+        if ((table == NULL) && ((ctx->help_slot) >= AT_COMMAND_LIST_SIZE)) {
+            ctx->help_type++;
+            ctx->help_slot = 0;
+            ctx->help_line = AT_HELP_LINE_TYPE;
+            continue;
+        }
+        // Check existence and type.
+        command = (table == NULL) ? ctx->commands_list[ctx->help_slot] : table->commands[ctx->help_slot];
+        if ((command == NULL) || ((command->type) != (ctx->help_type))) {
+            ctx->help_slot++;
+            continue;
+        }
+        _tx_begin_unit(ctx, AT_TX_UNIT_HELP);
+        status = _print_help_line(ctx, command, (AT_help_line_t) ctx->help_line);
+        status = _tx_end_unit(ctx, status);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+        lines_count++;
+        // Next line.
+        ctx->help_line++;
+        if ((ctx->help_line) >= AT_HELP_LINE_LAST) {
+            ctx->help_slot++;
+            ctx->help_line = AT_HELP_LINE_COMMAND;
+        }
+    }
+errors:
+    return status;
+}
+#endif
+
+#if defined(AT_STATISTICS) || defined(AT_METRICS)
+/*******************************************************************/
+static const AT_command_t *_get_slot_command(AT_context_t *ctx, uint32_t slot) {
+    // Local variables.
+    const AT_command_table_t *table = NULL;
+    uint32_t idx = 0;
+    // Slots of the list, then slots of the tables commands.
+    if (slot < AT_TABLE_SLOT) {
+        return ctx->commands_list[slot];
+    }
+    slot -= AT_TABLE_SLOT;
+    for (idx = 0; idx < ctx->commands_tables_count; idx++) {
+        table = &(ctx->commands_tables[idx]);
+        if ((slot >= table->slot_offset) && (slot < (uint32_t) (table->slot_offset + table->type_offset[AT_COMMAND_TYPE_LAST]))) {
+            return table->commands[slot - table->slot_offset];
+        }
+    }
+    return NULL;
+}
+
+#endif
+
+#ifdef AT_STATISTICS
+/*******************************************************************/
+AT_status_t _statistics_execution_callback(int32_t *error_code) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_context_t *ctx = _get_current_context();
+    const AT_command_t *command = NULL;
+    AT_statistics_t *statistics = NULL;
+    uint32_t idx = 0;
+    uint32_t phase = 0;
+    // Reset error code.
+    (*error_code) = 0;
+    // The output is printed again once the TX buffer is empty when it does not fit.
+    _tx_begin_unit(ctx, AT_TX_UNIT_COMMAND);
+    // One line per executed command: <command>:<count>,<min>/<avg>/<max> for each phase.
+    for (idx = 0; idx < AT_STATISTICS_NO_SLOT; idx++) {
+        statistics = &ctx->commands_statistics[idx];
+        if (statistics->count == 0) {
+            continue;
+        }
+        command = _get_slot_command(ctx, idx);
+        if (command == NULL) {
+            continue;
+        }
+        status = _print_command_header(ctx, command->type);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+        status = _print(ctx, command->syntax);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+        status = _print(ctx, ":");
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+        status = _print_number(ctx, statistics->count, 0);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+        for (phase = 0; phase < AT_STATISTICS_PHASE_LAST; phase++) {
+            _print(ctx, ",");
+            _print_number(ctx, statistics->min[phase], 0);
+            _print(ctx, "/");
+            _print_number(ctx, (statistics->sum[phase] / statistics->count), 0);
+            _print(ctx, "/");
+            status = _print_number(ctx, statistics->max[phase], 0);
+            if (status != AT_SUCCESS) {
+                goto errors;
+            }
+        }
+        status = _end_line(ctx);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+    }
+errors:
+    return _tx_end_unit(ctx, status);
+}
+#endif
+
+#ifdef AT_METRICS
+/*******************************************************************/
+static AT_status_t _metrics_print_counters(AT_context_t *ctx, const char *name, const uint32_t *counters, uint32_t counters_number) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    uint32_t idx = 0;
+    // <name>:<counter>,<counter>...
+    status = _print(ctx, name);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    for (idx = 0; idx < counters_number; idx++) {
+        status = _print(ctx, ((idx == 0) ? ":" : ","));
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+        status = _print_number(ctx, counters[idx], 0);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+    }
+    status = _end_line(ctx);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+AT_status_t _metrics_execution_callback(int32_t *error_code) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_context_t *ctx = _get_current_context();
+#ifdef AT_ASYNCHRONOUS_TX
+    uint32_t *counters = ctx->metrics_snapshot;
+#else
+    uint32_t counters[5];
+#endif
+    const AT_command_t *command = NULL;
+    uint32_t idx = 0;
+    uint8_t first_flag = 1;
+    // Reset error code.
+    (*error_code) = 0;
+    // The output is printed again once the TX buffer is empty when it does not fit, with the same RX and TX counters.
+    if (_tx_begin_unit(ctx, AT_TX_UNIT_COMMAND) == 0) {
+        counters[0] = ctx->metrics.rx_lines;
+        counters[1] = ctx->rx_dropped_lines_count;
+        counters[2] = ctx->metrics.rx_overflows;
+        counters[3] = ctx->metrics.tx_bytes;
+        counters[4] = ctx->metrics.tx_writes;
+    }
+    // RX:<lines>,<dropped>,<overflows> and TX:<bytes>,<writes>.
+    status = _metrics_print_counters(ctx, "RX", &counters[0], 3);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    status = _metrics_print_counters(ctx, "TX", &counters[3], 2);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    // STATUS:<status>=<count>,... for the non null counters only.
+    status = _print(ctx, "STATUS:");
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    for (idx = 0; idx < AT_ERROR_LAST; idx++) {
+        if (ctx->metrics.status_count[idx] == 0) {
+            continue;
+        }
+        if (first_flag == 0) {
+            _print(ctx, ",");
+        }
+        first_flag = 0;
+        _print_number(ctx, idx, 0);
+        _print(ctx, "=");
+        status = _print_number(ctx, ctx->metrics.status_count[idx], 0);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+    }
+    status = _end_line(ctx);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    // One line per executed command: <command>:<hits>.
+    for (idx = 0; idx < (AT_COMMAND_LIST_SIZE + AT_TABLE_SLOTS_NUMBER); idx++) {
+        if (ctx->metrics.command_hits[idx] == 0) {
+            continue;
+        }
+        command = _get_slot_command(ctx, idx);
+        if (command == NULL) {
+            continue;
+        }
+        status = _print_command_header(ctx, command->type);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+        status = _metrics_print_counters(ctx, command->syntax, &(ctx->metrics.command_hits[idx]), 1);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+    }
+errors:
+    return _tx_end_unit(ctx, status);
+}
+#endif
+
+/*******************************************************************/
+static void _default_rx_irq_callback(uint8_t data) {
+    _rx_irq_callback(&at_ctx, data);
+}
+
+/*******************************************************************/
+static void _default_rx_block_callback(const uint8_t *data, uint32_t size) {
+    _rx_block_callback(&at_ctx, data, size);
+}
+
+#ifdef AT_ASYNCHRONOUS_TX
+/*******************************************************************/
+static void _default_tx_done_callback(void) {
+    _tx_done_callback(&at_ctx);
+}
+#endif
+
+/*******************************************************************/
+static AT_status_t _default_hw_init(void *hw_context, AT_HW_API_ex_config_t *hw_api_config) {
+    // Local variables.
+    AT_HW_API_config_t hw_config;
+    // Default instance callbacks.
+    ((void) hw_context);
+    ((void) hw_api_config);
+    hw_config.rx_irq_callback = &_default_rx_irq_callback;
+    hw_config.rx_block_callback = &_default_rx_block_callback;
+#ifdef AT_ASYNCHRONOUS_TX
+    hw_config.tx_done_callback = &_default_tx_done_callback;
+#endif
+    return AT_HW_API_init(&hw_config);
+}
+
+/*******************************************************************/
+static AT_status_t _default_hw_de_init(void *hw_context) {
+    ((void) hw_context);
+    return AT_HW_API_de_init();
+}
+
+/*******************************************************************/
+static AT_status_t _default_hw_write(void *hw_context, uint8_t *data, uint32_t data_size_bytes) {
+    ((void) hw_context);
+    return AT_HW_API_write(data, data_size_bytes);
+}
+
+#ifdef AT_ASYNCHRONOUS_TX
+/*******************************************************************/
+static AT_status_t _default_hw_write_async(void *hw_context, uint8_t *data, uint32_t data_size_bytes) {
+    ((void) hw_context);
+    return AT_HW_API_write_async(data, data_size_bytes);
+}
+#endif
+
+/*** AT functions ***/
+
+/*******************************************************************/
+AT_status_t AT_init_ex(AT_handle_t *handle, AT_config_t *config, const AT_HW_API_ops_t *hw_ops, void *hw_context) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_context_t *ctx = handle;
+    AT_HW_API_ex_config_t hw_config;
+    // Check parameters.
+    if ((ctx == NULL) || (config == NULL) || (hw_ops == NULL)) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (config->process_callback == NULL) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Init context.
+    memset(ctx, 0x00, sizeof(AT_context_t));
+    ctx->hw_ops = hw_ops;
+    ctx->hw_context = hw_context;
+    ctx->flags.field.quiet = ((config->default_quiet_flag) == 0) ? 0 : 1;
+    ctx->flags.field.verbose = ((config->default_verbose_flag) == 0) ? 0 : 1;
+    ctx->flags.field.echo = ((config->default_echo_flag) == 0) ? 0 : 1;
+    ctx->flags.field.stop_on_error = ((config->stop_on_error_flag) == 0) ? 0 : 1;
+    ctx->process_callback = config->process_callback;
+    ctx->get_timestamp_callback = config->get_timestamp_callback;
+    ctx->rx_timeout = config->rx_timeout;
+#ifdef AT_WORKER
+    ctx->worker_callback = config->worker_callback;
+#endif
+#ifdef AT_ASYNCHRONOUS_TX
+    ctx->tx_wrap_index = AT_TX_BUFFER_SIZE;
+#endif
+#ifdef AT_STATISTICS
+    ctx->statistics_slot = AT_STATISTICS_NO_SLOT;
+#endif
+    // Init hardware interface.
+    hw_config.handle = ctx;
+    hw_config.rx_irq_callback = &_rx_irq_callback;
+    hw_config.rx_block_callback = &_rx_block_callback;
+#ifdef AT_ASYNCHRONOUS_TX
+    hw_config.tx_done_callback = &_tx_done_callback;
+#endif
+    status = ctx->hw_ops->init(ctx->hw_context, &hw_config);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    // Register built-in commands.
+    status = AT_register_table_ex(ctx, AT_BUILTIN_COMMANDS, (sizeof(AT_BUILTIN_COMMANDS) / sizeof(AT_command_t *)));
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    return AT_SUCCESS;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+AT_status_t AT_de_init_ex(AT_handle_t *handle) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_context_t *ctx = handle;
+    // Check parameter.
+    if ((ctx == NULL) || (ctx->hw_ops == NULL)) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Release hardware interface.
+    status = ctx->hw_ops->de_init(ctx->hw_context);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _check_command(const AT_command_t *command) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+#ifndef AT_NO_HELP
+    // Check write arguments.
+    if ((((command->write_callback) != NULL) || ((command->typed_write_callback) != NULL)) && ((command->write_arguments) == NULL)) {
+        status = AT_ERROR_WRITE_CALLBACK_WITHOUT_PARAMETER;
+        goto errors;
+    }
+#endif
+    // Check write schema.
+    if (((command->typed_write_callback) != NULL) && ((command->write_schema) == NULL)) {
+        status = AT_ERROR_COMMAND_SCHEMA;
+        goto errors;
+    }
+    if ((command->write_schema) != NULL) {
+        status = _check_schema(command->write_schema);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+    }
+    // Check type.
+    if ((command->type) >= AT_COMMAND_TYPE_LAST) {
+        status = AT_ERROR_COMMAND_TYPE;
+        goto errors;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+AT_status_t AT_register_command_ex(AT_handle_t *handle, const AT_command_t *command) {
+    // Local variables.
+    AT_status_t status = AT_ERROR_COMMANDS_LIST_FULL;
+    AT_context_t *ctx = handle;
+    uint32_t syntax_size = 0;
+    uint32_t low = 0;
+    uint32_t position = 0;
+    uint32_t idx;
+    // Check parameters.
+    if ((ctx == NULL) || (command == NULL)) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    status = _check_command(command);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    status = AT_ERROR_COMMANDS_LIST_FULL;
+    // Check if command is already registered: it is among the index entries with the same syntax.
+    syntax_size = strlen(command->syntax);
+    low = _get_index_offset(ctx, command->type);
+    position = _get_upper_bound(ctx, low, (low + ctx->commands_count[command->type]), command->syntax, syntax_size);
+    while ((position > low) && (_compare_syntax(ctx, ctx->commands_index[position - 1], command->syntax, syntax_size) == 0)) {
+        if (ctx->commands_list[ctx->commands_index[position - 1]] == command) {
+            status = AT_ERROR_COMMAND_ALREADY_REGISTERED;
+            goto errors;
+        }
+        position--;
+    }
+    // Search free location in list, from the lowest slot which may be free.
+    for (idx = ctx->commands_free; idx < (sizeof(ctx->commands_list) / sizeof(AT_command_t *)); idx++) {
+        // Check free index.
+        if (ctx->commands_list[idx] == NULL) {
+            // Register command and exit.
+#ifdef AT_INCREMENTAL_PARSING
+            ctx->commands_generation++;
+            AT_MEMORY_BARRIER();
+#endif
+            ctx->commands_list[idx] = command;
+            _index_insert(ctx, (AT_command_index_t) idx);
+#ifdef AT_INCREMENTAL_PARSING
+            AT_MEMORY_BARRIER();
+            ctx->commands_generation++;
+#endif
+#ifdef AT_STATISTICS
+            memset(&ctx->commands_statistics[idx], 0x00, sizeof(AT_statistics_t));
+#endif
+#ifdef AT_METRICS
+            ctx->metrics.command_hits[idx] = 0;
+#endif
+            ctx->commands_free = (AT_command_index_t) (idx + 1);
+            status = AT_SUCCESS;
+            break;
+        }
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+AT_status_t AT_unregister_command_ex(AT_handle_t *handle, const AT_command_t *command) {
+    // Local variables.
+    AT_status_t status = AT_ERROR_COMMAND_NOT_REGISTERED;
+    AT_context_t *ctx = handle;
+    uint32_t idx = 0;
+    // Check parameters.
+    if ((ctx == NULL) || (command == NULL)) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Search command in list.
+    for (idx = 0; idx < (sizeof(ctx->commands_list) / sizeof(AT_command_t *)); idx++) {
+        // Check pointer.
+        if (ctx->commands_list[idx] == command) {
+            // Release index and exit.
+#ifdef AT_INCREMENTAL_PARSING
+            ctx->commands_generation++;
+            AT_MEMORY_BARRIER();
+#endif
+            _index_remove(ctx, (AT_command_index_t) idx);
+            ctx->commands_list[idx] = NULL;
+#ifdef AT_READ_CACHE
+            _read_cache_invalidate(ctx, command);
+#endif
+            if (idx < ctx->commands_free) {
+                ctx->commands_free = (AT_command_index_t) idx;
+            }
+#ifdef AT_INCREMENTAL_PARSING
+            AT_MEMORY_BARRIER();
+            ctx->commands_generation++;
+#endif
+            status = AT_SUCCESS;
+            break;
+        }
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+AT_status_t AT_register_table_ex(AT_handle_t *handle, const AT_command_t *const table[], uint32_t table_size) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_context_t *ctx = handle;
+    AT_command_table_t command_table;
+    const AT_command_t *command = NULL;
+    const AT_command_t *previous_command = NULL;
+    uint32_t type = 0;
+    uint32_t idx = 0;
+    // Check parameters.
+    if ((ctx == NULL) || (table == NULL)) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if ((ctx->commands_tables_count) >= AT_COMMAND_TABLES_NUMBER) {
+        status = AT_ERROR_COMMANDS_TABLES_FULL;
+        goto errors;
+    }
+    if (table_size > AT_TABLE_SIZE_MAX) {
+        status = AT_ERROR_COMMANDS_TABLE;
+        goto errors;
+    }
+#if defined(AT_STATISTICS) || defined(AT_METRICS)
+    // Each command of the table takes a statistics and metrics slot.
+    if (table_size > (uint32_t) (AT_TABLE_SLOTS_NUMBER - ctx->tables_slots_count)) {
+        status = AT_ERROR_COMMANDS_TABLES_FULL;
+        goto errors;
+    }
+#endif
+    // Check if table is already registered.
+    for (idx = 0; idx < ctx->commands_tables_count; idx++) {
+        if (ctx->commands_tables[idx].commands == table) {
+            status = AT_ERROR_COMMAND_ALREADY_REGISTERED;
+            goto errors;
+        }
+    }
+    // Check commands and order in a single pass, and compute the position of each type.
+    command_table.commands = table;
+    for (idx = 0; idx < table_size; idx++) {
+        command = table[idx];
+        if (command == NULL) {
+            status = AT_ERROR_NULL_PARAMETER;
+            goto errors;
+        }
+        status = _check_command(command);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+        if ((previous_command != NULL) && (((command->type) < (previous_command->type)) || (((command->type) == (previous_command->type)) && (strcmp(previous_command->syntax, command->syntax) >= 0)))) {
+            status = AT_ERROR_COMMANDS_TABLE;
+            goto errors;
+        }
+        while (type <= (uint32_t) (command->type)) {
+            command_table.type_offset[type] = (uint16_t) idx;
+            type++;
+        }
+        previous_command = command;
+    }
+    while (type <= AT_COMMAND_TYPE_LAST) {
+        command_table.type_offset[type] = (uint16_t) table_size;
+        type++;
+    }
+    // Register table.
+#if defined(AT_STATISTICS) || defined(AT_METRICS)
+    command_table.slot_offset = ctx->tables_slots_count;
+    ctx->tables_slots_count = (uint16_t) (ctx->tables_slots_count + table_size);
+#endif
+#ifdef AT_STATISTICS
+    memset(&ctx->commands_statistics[AT_TABLE_SLOT + command_table.slot_offset], 0x00, (table_size * sizeof(AT_statistics_t)));
+#endif
+#ifdef AT_METRICS
+    memset(&ctx->metrics.command_hits[AT_TABLE_SLOT + command_table.slot_offset], 0x00, (table_size * sizeof(uint32_t)));
+#endif
+    ctx->commands_tables[ctx->commands_tables_count] = command_table;
+    ctx->commands_tables_count++;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+AT_status_t AT_process_ex(AT_handle_t *handle) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_context_t *ctx = handle;
+    AT_context_t *previous_ctx = at_current_ctx;
+    int32_t command_return_code = 0;
+    uint32_t command_start_idx = (sizeof(AT_HEADER) - 1);
+    AT_rx_line_t *line = NULL;
+    char *rx_buffer = NULL;
+#ifdef AT_STATISTICS
+    uint32_t timestamp = 0;
+#endif
+    // Check parameter.
+    if (ctx == NULL) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto end;
+    }
+#ifdef AT_ASYNCHRONOUS_TX
+    // A suspended output (or the staged replies) is resumed once the TX buffer is empty (AT_process() is called back by the TX done callback).
+    if (((ctx->tx_suspended_flag != 0) || (ctx->tx_reply_size != 0)) && (_tx_wait(ctx) != 0)) {
+        goto end;
+    }
+#endif
+#ifdef AT_URC
+#ifdef AT_NO_HELP
+    if (_print_urc(ctx) == AT_PENDING) {
+        goto suspended;
+    }
+#else
+    // Unsolicited result codes are printed between command responses (and not between help chunks).
+    if ((ctx->help_flag == 0) && (_print_urc(ctx) == AT_PENDING)) {
+        goto suspended;
+    }
+#endif
+#endif
+#ifdef AT_DATA_MODE
+    // Lines are processed once the frame is received.
+    if (((ctx->data_state != AT_DATA_STATE_IDLE) && (_tx_get_unit(ctx) == AT_TX_UNIT_NONE)) || (_tx_get_unit(ctx) == AT_TX_UNIT_DATA)) {
+        status = _process_data(ctx);
+        goto end;
+    }
+#endif
+#ifdef AT_WORKER
+    // Print the lines executed by the workers.
+    if (_process_jobs(ctx) == 0) {
+        goto end;
+    }
+#endif
+    // Check if a line is waiting for processing.
+    if (ctx->rx_read_count == ctx->rx_write_count) {
+        goto end;
+    }
+    AT_MEMORY_BARRIER();
+    line = &ctx->rx_lines[ctx->rx_read_count % AT_RX_LINES_NUMBER];
+    rx_buffer = line->buffer;
+    // Continue the status print of the line.
+    if (_tx_get_unit(ctx) == AT_TX_UNIT_STATUS) {
+        ctx->flags.field.running = 1;
+        at_current_ctx = ctx;
+        status = ctx->line_status;
+        command_return_code = ctx->line_error_code;
+        goto errors;
+    }
+    // Resume the line of a pending command once completed.
+    if (ctx->pending_state != AT_PENDING_STATE_IDLE) {
+        if (ctx->pending_state == AT_PENDING_STATE_WAITING) {
+            goto end;
+        }
+        ctx->flags.field.running = 1;
+        at_current_ctx = ctx;
+        status = _resume_line(ctx, &command_return_code);
+        goto pending;
+    }
+#ifdef AT_STATISTICS
+    ctx->statistics_slot = AT_STATISTICS_NO_SLOT;
+    ctx->statistics_timings[AT_STATISTICS_PHASE_LATENCY] = _get_timestamp(ctx) - line->timestamp;
+#endif
+    ctx->flags.field.running = 1;
+    at_current_ctx = ctx;
+#ifndef AT_NO_HELP
+    // Continue help of the current line.
+    if (ctx->help_flag != 0) {
+        goto help;
+    }
+#endif
+    // Echo.
+    if (ctx->flags.field.echo != 0) {
+        _tx_begin_unit(ctx, AT_TX_UNIT_ECHO);
+        _print_line(ctx, rx_buffer);
+        if (_tx_end_unit(ctx, AT_SUCCESS) == AT_PENDING) {
+            goto suspended;
+        }
+    }
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    // Lines longer than the buffer are never executed.
+    if (line->overflow != 0) {
+#ifdef AT_METRICS
+        ctx->metrics.rx_overflows++;
+#endif
+        status = AT_ERROR_INTERNAL_COMMAND_PARSING;
+        goto errors;
+    }
+#ifdef AT_INCREMENTAL_PARSING
+    // Line rejected during reception.
+    if (line->parse_state == AT_PARSE_STATE_REJECTED) {
+        status = (AT_status_t) line->parse_status;
+        goto errors;
+    }
+#endif
+    // Check header.
+    if (memcmp((uint8_t *) rx_buffer, AT_HEADER, command_start_idx) == 0) {
+#ifndef AT_NO_HELP
+        // Help command AT?.
+        if ((rx_buffer[command_start_idx] == AT_COMMAND_MARKER_READ_HELP) && (rx_buffer[command_start_idx + 1] == AT_COMMAND_MARKER_EXECUTION)) {
+            _start_help(ctx);
+            goto help;
+        }
+#endif
+        ctx->line_status = AT_SUCCESS;
+        ctx->line_error_code = 0;
+        ctx->line_error_command = NULL;
+        status = _execute_line(ctx, line, &rx_buffer[command_start_idx], &command_return_code);
+    } else {
+        status = AT_ERROR_INTERNAL_COMMAND_PARSING;
+    }
+pending:
+    // The line is kept until the pending command is completed.
+    if (status == AT_PENDING) {
+        _tx_flush(ctx);
+        ctx->flags.field.running = 0;
+        at_current_ctx = previous_ctx;
+        status = AT_SUCCESS;
+        // Or until the TX buffer is empty.
+        if (ctx->pending_state == AT_PENDING_STATE_TX) {
+            _tx_suspend(ctx);
+#ifdef AT_ASYNCHRONOUS_TX
+        } else if (ctx->tx_reply_size != 0) {
+            // The staged replies are written while the command is pending.
+            _tx_wait(ctx);
+#endif
+        }
+        goto end;
+    }
+#ifndef AT_NO_HELP
+help:
+    // Help is printed by chunks: the line is kept until the end of the help.
+    if (ctx->help_flag != 0) {
+        status = _print_help(ctx);
+        if (status == AT_PENDING) {
+            goto suspended;
+        }
+        if ((status == AT_SUCCESS) && (ctx->help_flag != 0)) {
+            _tx_flush(ctx);
+            ctx->flags.field.running = 0;
+            at_current_ctx = previous_ctx;
+            // Ask for processing of the next chunk.
+            if (ctx->process_callback != NULL) {
+                ctx->process_callback();
+            }
+            goto end;
+        }
+        ctx->help_flag = 0;
+    }
+#endif
+errors:
+#ifdef AT_STATISTICS
+    timestamp = _get_timestamp(ctx);
+#endif
+    // A reply reserved and not committed by the command is dropped.
+    if (ctx->reply_area != NULL) {
+        ctx->reply_area = NULL;
+        _end_line(ctx);
+    }
+    // Print status (kept in the line status fields until it is entirely written).
+    ctx->line_status = status;
+    ctx->line_error_code = command_return_code;
+    _tx_begin_unit(ctx, AT_TX_UNIT_STATUS);
+    _print_command_status(ctx, status, command_return_code);
+    if (_tx_end_unit(ctx, AT_SUCCESS) == AT_PENDING) {
+        goto suspended;
+    }
+#ifdef AT_STATISTICS
+    ctx->statistics_timings[AT_STATISTICS_PHASE_PRINT] = _get_timestamp(ctx) - timestamp;
+    _statistics_update(ctx);
+#endif
+    ctx->flags.field.running = 0;
+    at_current_ctx = previous_ctx;
+    _rx_release_line(ctx, line);
+    // Ask for processing of the next line.
+    if ((ctx->rx_read_count != ctx->rx_write_count) && (ctx->process_callback != NULL)) {
+        ctx->process_callback();
+    }
+    goto end;
+suspended:
+    // The output is resumed once the TX buffer is empty.
+    ctx->flags.field.running = 0;
+    at_current_ctx = previous_ctx;
+    status = AT_SUCCESS;
+    _tx_suspend(ctx);
+end:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _send_reply(AT_context_t *ctx, const AT_command_t *command, const char *reply, uint32_t reply_size) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    const AT_command_t *command_ptr = NULL;
+#ifdef AT_WORKER
+    char *area = NULL;
+    // Replies of a job are printed with its status.
+    if ((at_current_job != NULL) && (at_current_ctx == ctx)) {
+        if (at_current_job->job_reply_flag != 0) {
+            status = AT_ERROR_REPLY_STATE;
+            goto errors;
+        }
+        area = _job_reply_reserve(at_current_job, ((command != NULL) ? command : at_current_job->job_command), reply_size);
+        if (area == NULL) {
+            status = AT_ERROR_TX_BUFFER_SIZE;
+            goto errors;
+        }
+        memcpy(area, reply, reply_size);
+        _job_reply_commit(at_current_job, reply_size);
+        goto errors;
+    }
+#endif
+    // A reserved reply must be committed first.
+    if (ctx->reply_area != NULL) {
+        status = AT_ERROR_REPLY_STATE;
+        goto errors;
+    }
+    // Update current command pointer.
+    command_ptr = (command != NULL) ? command : ctx->current_command;
+    // The reply is written entirely or rejected, so that the caller can send it later.
+    if (ctx->flags.field.quiet == 0) {
+        status = _tx_check(ctx, (_get_reply_header_size(command_ptr) + reply_size + (sizeof(AT_REPLY_END) - 1)), 0);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+    }
+    status = _print_reply_header(ctx, command_ptr);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    status = _print_tab(ctx, (char *) reply, reply_size);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    status = _end_line(ctx);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    // Replies sent outside of a command are not followed by a status.
+    if (ctx->flags.field.running == 0) {
+        status = _tx_flush(ctx);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+AT_status_t AT_send_reply_ex(AT_handle_t *handle, const AT_command_t *command, char *reply) {
+    // Check parameters.
+    if ((handle == NULL) || (reply == NULL)) {
+        return AT_ERROR_NULL_PARAMETER;
+    }
+    if (reply[0] == '\0') {
+        return AT_ERROR_NULL_PARAMETER;
+    }
+    return _send_reply(handle, command, reply, strlen(reply));
+}
+
+/*******************************************************************/
+AT_status_t AT_send_reply_size_ex(AT_handle_t *handle, const AT_command_t *command, const char *reply, uint32_t reply_size) {
+    // Check parameters.
+    if ((handle == NULL) || (reply == NULL) || (reply_size == 0)) {
+        return AT_ERROR_NULL_PARAMETER;
+    }
+    return _send_reply(handle, command, reply, reply_size);
+}
+
+/*******************************************************************/
+AT_status_t AT_reply_begin_ex(AT_handle_t *handle, const AT_command_t *command, uint32_t size, char **reply) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_context_t *ctx = handle;
+    const AT_command_t *command_ptr = NULL;
+    char *area = NULL;
+    // Check parameters.
+    if ((ctx == NULL) || (reply == NULL)) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef AT_WORKER
+    // Replies of a job are reserved in its buffer.
+    if ((at_current_job != NULL) && (at_current_ctx == ctx)) {
+        if (at_current_job->job_reply_flag != 0) {
+            status = AT_ERROR_REPLY_STATE;
+            goto errors;
+        }
+        area = _job_reply_reserve(at_current_job, ((command != NULL) ? command : at_current_job->job_command), size);
+        if (area == NULL) {
+            status = AT_ERROR_TX_BUFFER_SIZE;
+            goto errors;
+        }
+        at_current_job->job_reply_reserved_size = (uint16_t) size;
+        at_current_job->job_reply_flag = 1;
+        (*reply) = area;
+        goto errors;
+    }
+#endif
+    if (ctx->reply_area != NULL) {
+        status = AT_ERROR_REPLY_STATE;
+        goto errors;
+    }
+    command_ptr = (command != NULL) ? command : ctx->current_command;
+    // Reserve header and reply at once, so that the reply area follows the header.
+    status = _tx_reserve(ctx, (_get_reply_header_size(command_ptr) + size), &area);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    status = _print_reply_header(ctx, command_ptr);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    status = _tx_reserve(ctx, size, &area);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    ctx->reply_area = area;
+    ctx->reply_reserved_size = (AT_tx_size_t) size;
+    (*reply) = area;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+AT_status_t AT_reply_commit_ex(AT_handle_t *handle, uint32_t reply_size) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_context_t *ctx = handle;
+    // Check parameter.
+    if (ctx == NULL) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef AT_WORKER
+    if ((at_current_job != NULL) && (at_current_ctx == ctx)) {
+        if (at_current_job->job_reply_flag == 0) {
+            status = AT_ERROR_REPLY_STATE;
+            goto errors;
+        }
+        if (reply_size > at_current_job->job_reply_reserved_size) {
+            status = AT_ERROR_TX_BUFFER_SIZE;
+            goto errors;
+        }
+        _job_reply_commit(at_current_job, reply_size);
+        at_current_job->job_reply_flag = 0;
+        goto errors;
+    }
+#endif
+    // Check state.
+    if (ctx->reply_area == NULL) {
+        status = AT_ERROR_REPLY_STATE;
+        goto errors;
+    }
+    if (reply_size > ctx->reply_reserved_size) {
+        status = AT_ERROR_TX_BUFFER_SIZE;
+        goto errors;
+    }
+    // The reply is already in place (not sent in quiet mode).
+    if ((ctx->flags.field.quiet == 0) && (reply_size > 0)) {
+#ifdef AT_READ_CACHE
+        if (ctx->read_cache_capture != NULL) {
+            _read_cache_append(ctx, ctx->reply_area, reply_size);
+        }
+#endif
+        _tx_commit(ctx, reply_size);
+    }
+    ctx->reply_area = NULL;
+    status = _end_line(ctx);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    // Replies sent outside of a command are not followed by a status.
+    if (ctx->flags.field.running == 0) {
+        status = _tx_flush(ctx);
+        if (status != AT_SUCCESS) {
+            goto errors;
+        }
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+AT_status_t AT_send_reply_hex_ex(AT_handle_t *handle, const AT_command_t *command, const uint8_t *data, uint32_t data_size) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    char *reply = NULL;
+    // Check parameters.
+    if ((handle == NULL) || (data == NULL) || (data_size == 0)) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Encode directly in the reply area.
+    status = AT_reply_begin_ex(handle, command, (2 * data_size), &reply);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    _encode_hex(data, data_size, reply);
+    status = AT_reply_commit_ex(handle, (2 * data_size));
+errors:
+    return status;
+}
+
+/*******************************************************************/
+AT_status_t AT_flush_ex(AT_handle_t *handle) {
+    // Check parameter.
+    if (handle == NULL) {
+        return AT_ERROR_NULL_PARAMETER;
+    }
+#ifdef AT_WORKER
+    // Replies of a job are printed with its status.
+    if ((at_current_job != NULL) && (at_current_ctx == handle)) {
+        return AT_SUCCESS;
+    }
+#endif
+    // Write staged output.
+    return _tx_flush(handle);
+}
+
+/*******************************************************************/
+AT_status_t AT_get_rx_dropped_lines_ex(AT_handle_t *handle, uint32_t *dropped_lines) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_context_t *ctx = handle;
+    // Check parameters.
+    if ((ctx == NULL) || (dropped_lines == NULL)) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    (*dropped_lines) = ctx->rx_dropped_lines_count;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+AT_status_t AT_get_rx_free_lines_ex(AT_handle_t *handle, uint32_t *free_lines) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_context_t *ctx = handle;
+    // Check parameters.
+    if ((ctx == NULL) || (free_lines == NULL)) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // A line being dropped is finished in the current buffer.
+    (*free_lines) = (ctx->rx_drop_flag != 0) ? 0 : (uint32_t) (AT_RX_LINES_NUMBER - ((uint8_t) (ctx->rx_write_count - ctx->rx_read_count)));
+errors:
+    return status;
+}
+
+/*******************************************************************/
+AT_status_t AT_get_activity_ex(AT_handle_t *handle, uint32_t *activity, uint32_t *wakeup_delay) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_context_t *ctx = handle;
+    uint32_t activity_bits = AT_ACTIVITY_NONE;
+    uint32_t delay = AT_WAKEUP_NONE;
+    uint32_t elapsed = 0;
+#ifdef AT_WORKER
+    uint8_t job_state = 0;
+#endif
+    // Check parameters.
+    if ((ctx == NULL) || (activity == NULL) || (wakeup_delay == NULL)) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Partial line, discarded by the next byte once the timeout is over.
+    if (ctx->rx_partial_flag != 0) {
+        elapsed = (ctx->rx_timeout != 0) ? ((uint32_t) (_get_timestamp(ctx) - ctx->rx_timestamp)) : 0;
+        if ((ctx->rx_timeout == 0) || (elapsed <= ctx->rx_timeout)) {
+            activity_bits |= AT_ACTIVITY_RX_LINE;
+        }
+        if ((ctx->rx_timeout != 0) && (elapsed <= ctx->rx_timeout)) {
+            delay = ctx->rx_timeout - elapsed;
+        }
+    }
+    // Received lines.
+    if (ctx->pending_state == AT_PENDING_STATE_WAITING) {
+        activity_bits |= AT_ACTIVITY_PENDING;
+#ifdef AT_ASYNCHRONOUS_TX
+    } else if (ctx->tx_wait_flag != 0) {
+        // AT_process() is called back once the output is written (TX activity).
+#endif
+#ifndef AT_NO_HELP
+    } else if (ctx->help_flag != 0) {
+        activity_bits |= AT_ACTIVITY_HELP;
+#endif
+    } else if (ctx->rx_read_count != ctx->rx_write_count) {
+#ifdef AT_WORKER
+        job_state = ctx->rx_lines[ctx->rx_read_count % AT_RX_LINES_NUMBER].job_state;
+        if ((job_state == AT_JOB_STATE_WAITING) || (job_state == AT_JOB_STATE_QUEUED) || (job_state == AT_JOB_STATE_RUNNING)) {
+            activity_bits |= AT_ACTIVITY_WORKER;
+        } else {
+            activity_bits |= AT_ACTIVITY_RX_PENDING;
+        }
+#else
+        activity_bits |= AT_ACTIVITY_RX_PENDING;
+#endif
+    }
+    // Output.
+#ifdef AT_ASYNCHRONOUS_TX
+    if ((ctx->tx_read_index != ctx->tx_write_index) || (ctx->tx_busy_size != 0) || (ctx->tx_reply_size != 0)) {
+        activity_bits |= AT_ACTIVITY_TX;
+    }
+#else
+    if (ctx->tx_buffer_size != 0) {
+        activity_bits |= AT_ACTIVITY_TX;
+    }
+#endif
+#ifdef AT_URC
+    if (ctx->urc_read_count != ctx->urc_write_count) {
+        activity_bits |= AT_ACTIVITY_URC;
+    }
+#endif
+#ifdef AT_DATA_MODE
+    // The data mode timeout is reported by AT_process().
+    if (ctx->data_state != AT_DATA_STATE_IDLE) {
+        activity_bits |= AT_ACTIVITY_DATA;
+        elapsed = (uint32_t) (_get_timestamp(ctx) - ctx->data_timestamp);
+        if ((ctx->data_state == AT_DATA_STATE_COMPLETE) || ((ctx->data_config.timeout != 0) && (elapsed >= ctx->data_config.timeout))) {
+            delay = 0;
+        } else if ((ctx->data_config.timeout != 0) && ((ctx->data_config.timeout - elapsed) < delay)) {
+            delay = ctx->data_config.timeout - elapsed;
+        }
+    }
+#endif
+    (*activity) = activity_bits;
+    (*wakeup_delay) = delay;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+uint8_t AT_can_sleep_ex(AT_handle_t *handle) {
+    // Local variables.
+    uint32_t activity = AT_ACTIVITY_NONE;
+    uint32_t wakeup_delay = 0;
+    // Sleep only if nothing is running and no timeout is over.
+    if (AT_get_activity_ex(handle, &activity, &wakeup_delay) != AT_SUCCESS) {
+        return 0;
+    }
+    return (((activity & AT_ACTIVITY_BUSY_MASK) == 0) && (wakeup_delay != 0)) ? 1 : 0;
+}
+
+#ifdef AT_URC
+/*******************************************************************/
+AT_status_t AT_post_urc_ex(AT_handle_t *handle, const char *urc) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_context_t *ctx = handle;
+    AT_urc_t *slot = NULL;
+    uint32_t urc_size = 0;
+    uint8_t write_count = 0;
+    // Check parameters.
+    if ((ctx == NULL) || (urc == NULL)) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    urc_size = strlen(urc);
+    if (urc_size >= AT_URC_SIZE) {
+        status = AT_ERROR_URC_SIZE;
+        goto errors;
+    }
+    // Reserve a slot, concurrent producers retry with the updated write count.
+    write_count = ctx->urc_write_count;
+    do {
+        if (((uint8_t) (write_count - ctx->urc_read_count)) >= AT_URC_NUMBER) {
+            status = AT_ERROR_URC_QUEUE_FULL;
+            goto errors;
+        }
+    } while (AT_COMPARE_AND_SWAP(&ctx->urc_write_count, &write_count, (uint8_t) (write_count + 1)) == 0);
+    // Copy and publish code.
+    slot = &ctx->urc[write_count % AT_URC_NUMBER];
+    memcpy(slot->buffer, urc, (urc_size + 1));
+    AT_MEMORY_BARRIER();
+    slot->ready = 1;
+    // Ask for processing.
+    if (ctx->process_callback != NULL) {
+        ctx->process_callback();
+    }
+errors:
+    return status;
+}
+#endif
+
+#ifdef AT_READ_CACHE
+/*******************************************************************/
+AT_status_t AT_invalidate_ex(AT_handle_t *handle, const AT_command_t *command) {
+    // Check parameter.
+    if (handle == NULL) {
+        return AT_ERROR_NULL_PARAMETER;
+    }
+    _read_cache_invalidate(handle, command);
+    return AT_SUCCESS;
+}
+#endif
+
+/*******************************************************************/
+AT_status_t AT_complete_ex(AT_handle_t *handle, const AT_command_t *command, AT_status_t status, int32_t error_code) {
+    // Local variables.
+    AT_status_t at_status = AT_SUCCESS;
+    AT_context_t *ctx = handle;
+    const AT_command_t *pending_command = NULL;
+    // Check parameter.
+    if (ctx == NULL) {
+        at_status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef AT_WORKER
+    // Jobs are not deferred.
+    if ((at_current_job != NULL) && (at_current_ctx == ctx)) {
+        at_status = AT_ERROR_COMMAND_NOT_PENDING;
+        goto errors;
+    }
+#endif
+    // The command is either waiting, or still executing its callback.
+    if (ctx->pending_state == AT_PENDING_STATE_WAITING) {
+        pending_command = ctx->pending_command;
+    } else if ((ctx->pending_state == AT_PENDING_STATE_IDLE) && (ctx->flags.field.running != 0)) {
+        pending_command = ctx->current_command;
+    }
+    if ((pending_command == NULL) || ((command != NULL) && (command != pending_command))) {
+        at_status = AT_ERROR_COMMAND_NOT_PENDING;
+        goto errors;
+    }
+    ctx->pending_status = status;
+    ctx->pending_error_code = error_code;
+    ctx->pending_state = AT_PENDING_STATE_COMPLETE;
+    // Ask for processing to print the status, unless the command is still executing.
+    if ((ctx->flags.field.running == 0) && (ctx->process_callback != NULL)) {
+        ctx->process_callback();
+    }
+errors:
+    return at_status;
+}
+
+#ifdef AT_WORKER
+/*******************************************************************/
+AT_status_t AT_worker_process_ex(AT_handle_t *handle) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_context_t *ctx = handle;
+    AT_context_t *previous_ctx = at_current_ctx;
+    AT_rx_line_t *previous_job = at_current_job;
+    AT_rx_line_t *line = NULL;
+    uint8_t read_count = 0;
+    uint8_t expected_state = 0;
+    uint32_t idx = 0;
+    char command[AT_BUFFER_SIZE];
+    // Check parameter.
+    if (ctx == NULL) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Claim the oldest queued job, queued lines are not released until their job is done.
+    read_count = ctx->rx_read_count;
+    for (idx = 0; idx < AT_RX_LINES_NUMBER; idx++) {
+        line = &ctx->rx_lines[(uint8_t) (read_count + idx) % AT_RX_LINES_NUMBER];
+        expected_state = AT_JOB_STATE_QUEUED;
+        if ((line->job_state == AT_JOB_STATE_QUEUED) && (AT_COMPARE_AND_SWAP(&(line->job_state), &expected_state, AT_JOB_STATE_RUNNING) != 0)) {
+            break;
+        }
+        line = NULL;
+    }
+    if (line == NULL) {
+        status = AT_ERROR_WORKER_NO_JOB;
+        goto errors;
+    }
+    AT_MEMORY_BARRIER();
+    // Arguments are parsed in a copy, the line is kept for the echo.
+    memcpy(command, &(line->buffer[line->job_start]), ((uint32_t) line->size + 1 - line->job_start));
+    at_current_ctx = ctx;
+    at_current_job = line;
+    line->job_error_code = 0;
+    line->job_status = _call_command(ctx, line->job_command, command, line->job_command_size, (AT_command_type_t) line->job_type, &(line->job_error_code));
+    at_current_job = previous_job;
+    at_current_ctx = previous_ctx;
+    // Give the job back to AT_process().
+    AT_MEMORY_BARRIER();
+    line->job_state = AT_JOB_STATE_DONE;
+    if (ctx->process_callback != NULL) {
+        ctx->process_callback();
+    }
+errors:
+    return status;
+}
+#endif
+
+#ifdef AT_DATA_MODE
+/*******************************************************************/
+AT_status_t AT_enter_data_mode_ex(AT_handle_t *handle, AT_data_mode_config_t *config) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_context_t *ctx = handle;
+    // Check parameters.
+    if ((ctx == NULL) || (config == NULL)) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if ((config->data_callback == NULL) || (config->end_callback == NULL)) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Check state.
+    if ((ctx->flags.field.running == 0) || (ctx->data_state != AT_DATA_STATE_IDLE)) {
+        status = AT_ERROR_DATA_MODE;
+        goto errors;
+    }
+#ifdef AT_WORKER
+    // Jobs can not switch the reception.
+    if ((at_current_job != NULL) && (at_current_ctx == ctx)) {
+        status = AT_ERROR_DATA_MODE;
+        goto errors;
+    }
+#endif
+    // Init frame reception.
+    ctx->data_config = (*config);
+    ctx->data_crc = AT_DATA_CRC_INITIAL_VALUE;
+    ctx->data_received_crc = 0;
+    ctx->data_crc_size = 0;
+    ctx->data_remaining_size = config->size;
+    ctx->data_timestamp = _get_timestamp(ctx);
+    // Switch reception.
+    AT_MEMORY_BARRIER();
+    ctx->data_state = AT_DATA_STATE_RECEIVING;
+errors:
+    return status;
+}
+#endif
+
+/*******************************************************************/
+AT_handle_t *AT_get_current_handle(void) {
+    return _get_current_context();
+}
+
+/*******************************************************************/
+AT_status_t AT_init(AT_config_t *config) {
+    return AT_init_ex(&at_ctx, config, &AT_HW_API_DEFAULT_OPS, NULL);
+}
+
+/*******************************************************************/
+AT_status_t AT_de_init(void) {
+    return AT_de_init_ex(&at_ctx);
+}
+
+/*******************************************************************/
+AT_status_t AT_register_command(const AT_command_t *command) {
+    return AT_register_command_ex(&at_ctx, command);
+}
+
+/*******************************************************************/
+AT_status_t AT_unregister_command(const AT_command_t *command) {
+    return AT_unregister_command_ex(&at_ctx, command);
+}
+
+/*******************************************************************/
+AT_status_t AT_register_table(const AT_command_t *const table[], uint32_t table_size) {
+    return AT_register_table_ex(&at_ctx, table, table_size);
+}
+
+/*******************************************************************/
+AT_status_t AT_process(void) {
+    return AT_process_ex(&at_ctx);
+}
+
+/*******************************************************************/
+AT_status_t AT_send_reply(const AT_command_t *command, char *reply) {
+    return AT_send_reply_ex(_get_current_context(), command, reply);
+}
+
+/*******************************************************************/
+AT_status_t AT_send_reply_size(const AT_command_t *command, const char *reply, uint32_t reply_size) {
+    return AT_send_reply_size_ex(_get_current_context(), command, reply, reply_size);
+}
+
+/*******************************************************************/
+AT_status_t AT_reply_begin(const AT_command_t *command, uint32_t size, char **reply) {
+    return AT_reply_begin_ex(_get_current_context(), command, size, reply);
+}
+
+/*******************************************************************/
+AT_status_t AT_reply_commit(uint32_t reply_size) {
+    return AT_reply_commit_ex(_get_current_context(), reply_size);
+}
+
+/*******************************************************************/
+AT_status_t AT_send_reply_hex(const AT_command_t *command, const uint8_t *data, uint32_t data_size) {
+    return AT_send_reply_hex_ex(_get_current_context(), command, data, data_size);
+}
+
+/*******************************************************************/
+AT_status_t AT_decode_hex(const char *hex, uint32_t hex_size, uint8_t *data, uint32_t data_size) {
+    // Check parameters.
+    if ((hex == NULL) || (hex_size == 0)) {
+        return AT_ERROR_NULL_PARAMETER;
+    }
+    if ((data != NULL) && (data_size < (hex_size / 2))) {
+        return AT_ERROR_HEX_SIZE;
+    }
+    return ((_decode_hex(hex, hex_size, data) == AT_SUCCESS) ? AT_SUCCESS : AT_ERROR_HEX_FORMAT);
+}
+
+/*******************************************************************/
+AT_status_t AT_encode_hex(const uint8_t *data, uint32_t data_size, char *hex, uint32_t hex_size) {
+    // Check parameters.
+    if ((data == NULL) || (hex == NULL)) {
+        return AT_ERROR_NULL_PARAMETER;
+    }
+    if (hex_size <= (2 * data_size)) {
+        return AT_ERROR_HEX_SIZE;
+    }
+    _encode_hex(data, data_size, hex);
+    hex[2 * data_size] = '\0';
+    return AT_SUCCESS;
+}
+
+/*******************************************************************/
+AT_status_t AT_flush(void) {
+    return AT_flush_ex(_get_current_context());
+}
+
+/*******************************************************************/
+AT_status_t AT_get_rx_dropped_lines(uint32_t *dropped_lines) {
+    return AT_get_rx_dropped_lines_ex(&at_ctx, dropped_lines);
+}
+
+/*******************************************************************/
+AT_status_t AT_get_rx_free_lines(uint32_t *free_lines) {
+    return AT_get_rx_free_lines_ex(&at_ctx, free_lines);
+}
+
+/*******************************************************************/
+AT_status_t AT_get_activity(uint32_t *activity, uint32_t *wakeup_delay) {
+    return AT_get_activity_ex(&at_ctx, activity, wakeup_delay);
+}
+
+/*******************************************************************/
+uint8_t AT_can_sleep(void) {
+    return AT_can_sleep_ex(&at_ctx);
+}
+
+#ifdef AT_URC
+/*******************************************************************/
+AT_status_t AT_post_urc(const char *urc) {
+    return AT_post_urc_ex(&at_ctx, urc);
+}
+#endif
+
+#ifdef AT_READ_CACHE
+/*******************************************************************/
+AT_status_t AT_invalidate(const AT_command_t *command) {
+    return AT_invalidate_ex(_get_current_context(), command);
+}
+#endif
+
+/*******************************************************************/
+AT_status_t AT_complete(const AT_command_t *command, AT_status_t status, int32_t error_code) {
+    return AT_complete_ex(_get_current_context(), command, status, error_code);
+}
+
+#ifdef AT_WORKER
+/*******************************************************************/
+AT_status_t AT_worker_process(void) {
+    return AT_worker_process_ex(&at_ctx);
+}
+#endif
+
+#ifdef AT_DATA_MODE
+/*******************************************************************/
+AT_status_t AT_enter_data_mode(AT_data_mode_config_t *config) {
+    return AT_enter_data_mode_ex(_get_current_context(), config);
+}
+#endif
@@ -37,8 +37,15 @@
 #include "at_hw_api.h"
 
 #include "at.h"
+#include "stddef.h"
 #include "stdint.h"
 
+#ifdef AT_ASYNCHRONOUS_TX
+/*** AT HW API local global variables ***/
+
+static AT_HW_API_tx_done_cb_t at_hw_api_tx_done_callback = NULL;
+#endif
+
 /*** AT HW API functions ***/
 
 /*******************************************************************/
@@ -46,7 +53,11 @@ AT_status_t __attribute__((weak)) AT_HW_API_init(AT_HW_API_config_t *hw_api_conf
     // Local variables.
     AT_status_t status = AT_SUCCESS;
     /* To be implemented by the device manufacturer */
+#ifdef AT_ASYNCHRONOUS_TX
+    at_hw_api_tx_done_callback = hw_api_config->tx_done_callback;
+#else
     ((void) hw_api_config);
+#endif
     return status;
 }
 
@@ -67,3 +78,19 @@ AT_status_t __attribute__((weak)) AT_HW_API_write(uint8_t *data, uint32_t data_s
     ((void) data_size_bytes);
     return status;
 }
+
+#ifdef AT_ASYNCHRONOUS_TX
+/*******************************************************************/
+AT_status_t __attribute__((weak)) AT_HW_API_write_async(uint8_t *data, uint32_t data_size_bytes) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    /* To be implemented by the device manufacturer */
+    ((void) data);
+    ((void) data_size_bytes);
+    // Transfer complete.
+    if (at_hw_api_tx_done_callback != NULL) {
+        at_hw_api_tx_done_callback();
+    }
+    return status;
+}
+#endif
@@ -0,0 +1,764 @@
+/*!*****************************************************************
+ * \file    at_hw_posix.c
+ * \brief   AT POSIX hardware interface (tty, pty and sockets).
+ *******************************************************************
+ * \copyright
+ *
+ * Copyright (c) 2024, UnaBiz SAS
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  1 Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  2 Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *  3 Neither the name of UnaBiz SAS nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *******************************************************************/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "at_hw_posix.h"
+
+#include "at.h"
+#include "at_hw_api.h"
+#include "errno.h"
+#include "fcntl.h"
+#include "poll.h"
+#include "stdint.h"
+#include "stdlib.h"
+#include "string.h"
+#include "sys/epoll.h"
+#include "sys/eventfd.h"
+#include "sys/uio.h"
+#include "termios.h"
+#include "unistd.h"
+
+/*** AT HW POSIX local macros ***/
+
+#define AT_HW_POSIX_LINE_END                '\r'
+#define AT_HW_POSIX_LINE_FEED               '\n'
+
+// Activities which need another AT_process_ex() call.
+#define AT_HW_POSIX_ACTIVITY_MASK           (AT_ACTIVITY_RX_PENDING | AT_ACTIVITY_HELP | AT_ACTIVITY_URC)
+
+/*** AT HW POSIX local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint32_t baud_rate;
+    speed_t speed;
+} AT_HW_POSIX_baud_rate_t;
+
+/*** AT HW POSIX local functions declaration ***/
+
+static AT_status_t _posix_init(void *hw_context, AT_HW_API_ex_config_t *hw_api_config);
+static AT_status_t _posix_de_init(void *hw_context);
+static AT_status_t _posix_write(void *hw_context, uint8_t *data, uint32_t data_size_bytes);
+#ifdef AT_ASYNCHRONOUS_TX
+static AT_status_t _posix_write_async(void *hw_context, uint8_t *data, uint32_t data_size_bytes);
+#endif
+
+/*** AT HW POSIX local global variables ***/
+
+static const AT_HW_POSIX_baud_rate_t AT_HW_POSIX_BAUD_RATES[] = {
+    {9600, B9600},
+    {19200, B19200},
+    {38400, B38400},
+    {57600, B57600},
+    {115200, B115200},
+    {230400, B230400},
+    {460800, B460800},
+    {921600, B921600},
+};
+
+/*** AT HW POSIX global variables ***/
+
+const AT_HW_API_ops_t AT_HW_POSIX_OPS = {
+    .init = &_posix_init,
+    .de_init = &_posix_de_init,
+#ifdef AT_ASYNCHRONOUS_TX
+    .write = NULL,
+    .write_async = &_posix_write_async,
+#else
+    .write = &_posix_write,
+#endif
+};
+
+/*** AT HW POSIX local functions ***/
+
+/*******************************************************************/
+static AT_status_t _set_raw_mode(int fd, uint32_t baud_rate) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    struct termios attributes;
+    uint32_t idx = 0;
+    if (tcgetattr(fd, &attributes) != 0) {
+        status = AT_ERROR_AT_HW_API;
+        goto errors;
+    }
+    cfmakeraw(&attributes);
+    attributes.c_cflag |= (CLOCAL | CREAD);
+    attributes.c_cflag &= ~((tcflag_t) CRTSCTS);
+    attributes.c_cc[VMIN] = 1;
+    attributes.c_cc[VTIME] = 0;
+    if (baud_rate != 0) {
+        for (idx = 0; idx < (sizeof(AT_HW_POSIX_BAUD_RATES) / sizeof(AT_HW_POSIX_baud_rate_t)); idx++) {
+            if (AT_HW_POSIX_BAUD_RATES[idx].baud_rate == baud_rate) {
+                break;
+            }
+        }
+        if ((idx >= (sizeof(AT_HW_POSIX_BAUD_RATES) / sizeof(AT_HW_POSIX_baud_rate_t))) || (cfsetspeed(&attributes, AT_HW_POSIX_BAUD_RATES[idx].speed) != 0)) {
+            status = AT_ERROR_AT_HW_API;
+            goto errors;
+        }
+    }
+    if (tcsetattr(fd, TCSANOW, &attributes) != 0) {
+        status = AT_ERROR_AT_HW_API;
+        goto errors;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static void _activate(AT_HW_POSIX_port_t *port) {
+    // Ports are processed once per call, even with several events.
+    if ((port->loop == NULL) || (port->active_flag != 0)) {
+        return;
+    }
+    port->active_flag = 1;
+    port->active_next = port->loop->active;
+    port->loop->active = port;
+}
+
+/*******************************************************************/
+static void _activate_all(AT_HW_POSIX_loop_t *loop) {
+    // Local variables.
+    AT_HW_POSIX_port_t *port = loop->ports;
+    while (port != NULL) {
+        _activate(port);
+        port = port->next;
+    }
+}
+
+/*******************************************************************/
+static void _unlink(AT_HW_POSIX_port_t **list, AT_HW_POSIX_port_t *port, uint8_t active_list_flag) {
+    // Local variables.
+    AT_HW_POSIX_port_t **link = list;
+    while ((*link) != NULL) {
+        if ((*link) == port) {
+            (*link) = (active_list_flag != 0) ? port->active_next : port->next;
+            return;
+        }
+        link = (active_list_flag != 0) ? &((*link)->active_next) : &((*link)->next);
+    }
+}
+
+/*******************************************************************/
+static AT_status_t _update_events(AT_HW_POSIX_port_t *port) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    struct epoll_event event;
+    uint32_t events = 0;
+    if ((port->loop == NULL) || (port->closed_flag != 0)) {
+        goto errors;
+    }
+    // Stop reading while received bytes are held, wait for the file descriptor while output is pending.
+    if ((port->rx_offset) >= (port->rx_size)) {
+        events |= EPOLLIN;
+    }
+    if ((port->tx_size) != 0) {
+        events |= EPOLLOUT;
+    }
+    if (events == port->events) {
+        goto errors;
+    }
+    event.events = events;
+    event.data.ptr = port;
+    if (epoll_ctl(port->loop->epoll_fd, EPOLL_CTL_MOD, port->fd, &event) != 0) {
+        status = AT_ERROR_AT_HW_API;
+        goto errors;
+    }
+    port->events = events;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _flush(AT_HW_POSIX_port_t *port) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    struct iovec iov[2];
+    int iov_count = 0;
+    ssize_t written = 0;
+    while ((port->tx_size) != 0) {
+        // Both parts of the TX ring are written at once.
+        iov[0].iov_base = &(port->tx_buffer[port->tx_read_index]);
+        iov[0].iov_len = AT_HW_POSIX_TX_BUFFER_SIZE - port->tx_read_index;
+        iov_count = 1;
+        if (iov[0].iov_len >= port->tx_size) {
+            iov[0].iov_len = port->tx_size;
+        } else {
+            iov[1].iov_base = port->tx_buffer;
+            iov[1].iov_len = port->tx_size - iov[0].iov_len;
+            iov_count = 2;
+        }
+        written = writev(port->fd, iov, iov_count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+                break;
+            }
+            port->closed_flag = 1;
+            status = AT_ERROR_AT_HW_API;
+            goto errors;
+        }
+        port->tx_read_index = (port->tx_read_index + (uint32_t) written) % AT_HW_POSIX_TX_BUFFER_SIZE;
+        port->tx_size -= (uint32_t) written;
+    }
+    status = _update_events(port);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _wait_tx_space(AT_HW_POSIX_port_t *port) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    struct pollfd poll_fd;
+    int result = 0;
+    status = _flush(port);
+    if ((status != AT_SUCCESS) || ((port->tx_size) < AT_HW_POSIX_TX_BUFFER_SIZE)) {
+        goto errors;
+    }
+    // The write operation is synchronous: wait for the file descriptor.
+    poll_fd.fd = port->fd;
+    poll_fd.events = POLLOUT;
+    do {
+        result = poll(&poll_fd, 1, ((port->write_timeout_ms) == 0) ? -1 : (int) port->write_timeout_ms);
+    } while ((result < 0) && (errno == EINTR));
+    if (result <= 0) {
+        status = AT_ERROR_AT_HW_API;
+        goto errors;
+    }
+    status = _flush(port);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static void _read(AT_HW_POSIX_port_t *port) {
+    // Local variables.
+    ssize_t size = 0;
+    // Held bytes are fed first.
+    if ((port->rx_offset) < (port->rx_size)) {
+        return;
+    }
+    size = read(port->fd, port->rx_buffer, AT_HW_POSIX_RX_BUFFER_SIZE);
+    if (size > 0) {
+        port->rx_offset = 0;
+        port->rx_size = (uint32_t) size;
+    } else if ((size == 0) || ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))) {
+        port->closed_flag = 1;
+    }
+}
+
+/*******************************************************************/
+static void _feed(AT_HW_POSIX_port_t *port) {
+    // Local variables.
+    const uint8_t *data = NULL;
+    const uint8_t *end_marker = NULL;
+    uint32_t size = 0;
+    uint32_t segment_size = 0;
+    uint32_t free_lines = 0;
+    while ((port->rx_offset) < (port->rx_size)) {
+        data = &(port->rx_buffer[port->rx_offset]);
+        size = port->rx_size - port->rx_offset;
+        if ((port->partial_flag == 0) && (port->skip_lf_flag != 0) && (data[0] == AT_HW_POSIX_LINE_FEED)) {
+            port->rx_offset++;
+            continue;
+        }
+        // Hold the next lines while all the RX line buffers are busy (the current partial line has its buffer).
+        AT_get_rx_free_lines_ex(port->hw_config.handle, &free_lines);
+        if ((port->partial_flag != 0) && (free_lines == 0)) {
+            free_lines = 1;
+        }
+        if (free_lines == 0) {
+            break;
+        }
+        // Line feeds are only skipped at the start of the lines.
+        if (port->skip_lf_flag != 0) {
+            free_lines = 1;
+        }
+        // Feed at once the lines fitting in the free buffers.
+        segment_size = 0;
+        while ((free_lines > 0) && (segment_size < size)) {
+            end_marker = (const uint8_t *) memchr(&data[segment_size], AT_HW_POSIX_LINE_END, size - segment_size);
+            if (end_marker == NULL) {
+                segment_size = size;
+                port->partial_flag = 1;
+                break;
+            }
+            segment_size = (uint32_t) (end_marker - data) + 1;
+            port->partial_flag = 0;
+            free_lines--;
+        }
+        port->hw_config.rx_block_callback(port->hw_config.handle, data, segment_size);
+        port->rx_offset += segment_size;
+    }
+}
+
+/*******************************************************************/
+static uint8_t _has_work(AT_HW_POSIX_port_t *port) {
+    // Local variables.
+    uint32_t activity = 0;
+    uint32_t wakeup_delay = 0;
+    uint32_t free_lines = 0;
+    AT_get_activity_ex(port->hw_config.handle, &activity, &wakeup_delay);
+    if ((activity & AT_HW_POSIX_ACTIVITY_MASK) != 0) {
+        return 1;
+    }
+    // Held bytes which can be fed.
+    if ((port->rx_offset) < (port->rx_size)) {
+        AT_get_rx_free_lines_ex(port->hw_config.handle, &free_lines);
+        if ((free_lines != 0) || (port->partial_flag != 0)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*******************************************************************/
+static uint8_t _process(AT_HW_POSIX_port_t *port) {
+    // Local variables.
+    uint32_t idx = 0;
+    uint8_t work_flag = _has_work(port);
+    for (idx = 0; (idx < AT_HW_POSIX_PROCESS_MAX) && (work_flag != 0); idx++) {
+        _feed(port);
+        AT_process_ex(port->hw_config.handle);
+        work_flag = _has_work(port);
+    }
+    // Output of all the processed commands is written at once.
+    _flush(port);
+    // Resume reading once the held bytes are fed.
+    _update_events(port);
+    return work_flag;
+}
+
+/*******************************************************************/
+static AT_status_t _posix_init(void *hw_context, AT_HW_API_ex_config_t *hw_api_config) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_HW_POSIX_port_t *port = (AT_HW_POSIX_port_t *) hw_context;
+    int flags = 0;
+    // Check parameters.
+    if ((port == NULL) || (hw_api_config == NULL)) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    flags = fcntl(port->fd, F_GETFL);
+    if ((flags < 0) || (fcntl(port->fd, F_SETFL, flags | O_NONBLOCK) != 0)) {
+        status = AT_ERROR_AT_HW_API;
+        goto errors;
+    }
+    port->hw_config = (*hw_api_config);
+    port->loop = NULL;
+    port->next = NULL;
+    port->active_next = NULL;
+    port->events = 0;
+    port->active_flag = 0;
+    port->closed_flag = 0;
+    port->partial_flag = 0;
+    port->rx_offset = 0;
+    port->rx_size = 0;
+    port->tx_read_index = 0;
+    port->tx_size = 0;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _posix_de_init(void *hw_context) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_HW_POSIX_port_t *port = (AT_HW_POSIX_port_t *) hw_context;
+    // Check parameter.
+    if (port == NULL) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // The file descriptor is owned by the application.
+    status = AT_HW_POSIX_loop_remove(port);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _posix_write(void *hw_context, uint8_t *data, uint32_t data_size_bytes) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_HW_POSIX_port_t *port = (AT_HW_POSIX_port_t *) hw_context;
+    uint32_t write_index = 0;
+    uint32_t copy_size = 0;
+    // Check parameters.
+    if ((port == NULL) || (data == NULL)) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (port->closed_flag != 0) {
+        status = AT_ERROR_AT_HW_API;
+        goto errors;
+    }
+    // Copy in the TX ring, written at the end of the loop iteration.
+    while (data_size_bytes > 0) {
+        if ((port->tx_size) >= AT_HW_POSIX_TX_BUFFER_SIZE) {
+            status = _wait_tx_space(port);
+            if (status != AT_SUCCESS) {
+                goto errors;
+            }
+            continue;
+        }
+        write_index = (port->tx_read_index + port->tx_size) % AT_HW_POSIX_TX_BUFFER_SIZE;
+        copy_size = AT_HW_POSIX_TX_BUFFER_SIZE - port->tx_size;
+        if (copy_size > (AT_HW_POSIX_TX_BUFFER_SIZE - write_index)) {
+            copy_size = AT_HW_POSIX_TX_BUFFER_SIZE - write_index;
+        }
+        if (copy_size > data_size_bytes) {
+            copy_size = data_size_bytes;
+        }
+        memcpy(&(port->tx_buffer[write_index]), data, copy_size);
+        port->tx_size += copy_size;
+        data += copy_size;
+        data_size_bytes -= copy_size;
+    }
+errors:
+    return status;
+}
+
+#ifdef AT_ASYNCHRONOUS_TX
+/*******************************************************************/
+static AT_status_t _posix_write_async(void *hw_context, uint8_t *data, uint32_t data_size_bytes) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_HW_POSIX_port_t *port = (AT_HW_POSIX_port_t *) hw_context;
+    // The parser waits for the TX done callback when its TX buffer is full, the loop can not complete the transfer later:
+    // data is copied in the TX ring and the transfer is completed immediately.
+    status = _posix_write(hw_context, data, data_size_bytes);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    port->hw_config.tx_done_callback(port->hw_config.handle);
+errors:
+    return status;
+}
+#endif
+
+/*** AT HW POSIX functions ***/
+
+/*******************************************************************/
+AT_status_t AT_HW_POSIX_open_tty(const char *path, uint32_t baud_rate, int *fd) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    int tty_fd = -1;
+    // Check parameters.
+    if ((path == NULL) || (fd == NULL)) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    tty_fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (tty_fd < 0) {
+        status = AT_ERROR_AT_HW_API;
+        goto errors;
+    }
+    status = _set_raw_mode(tty_fd, baud_rate);
+    if (status != AT_SUCCESS) {
+        close(tty_fd);
+        goto errors;
+    }
+    (*fd) = tty_fd;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+AT_status_t AT_HW_POSIX_open_pty(int *fd, int *slave_fd, char *slave_name, uint32_t slave_name_size) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    int master = -1;
+    int slave = -1;
+    // Check parameters.
+    if ((fd == NULL) || (slave_fd == NULL) || (slave_name == NULL)) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    master = posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if ((master < 0) || (grantpt(master) != 0) || (unlockpt(master) != 0) || (ptsname_r(master, slave_name, slave_name_size) != 0)) {
+        status = AT_ERROR_AT_HW_API;
+        goto errors;
+    }
+    slave = open(slave_name, O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (slave < 0) {
+        status = AT_ERROR_AT_HW_API;
+        goto errors;
+    }
+    // The line discipline of the pair is configured on the slave side.
+    status = _set_raw_mode(slave, 0);
+    if (status != AT_SUCCESS) {
+        goto errors;
+    }
+    (*fd) = master;
+    (*slave_fd) = slave;
+    return status;
+errors:
+    if (slave >= 0) {
+        close(slave);
+    }
+    if (master >= 0) {
+        close(master);
+    }
+    return status;
+}
+
+/*******************************************************************/
+AT_status_t AT_HW_POSIX_loop_init(AT_HW_POSIX_loop_t *loop) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    struct epoll_event event;
+    // Check parameter.
+    if (loop == NULL) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    loop->ports = NULL;
+    loop->active = NULL;
+    loop->busy = NULL;
+    loop->event_fd = -1;
+    loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (loop->epoll_fd < 0) {
+        status = AT_ERROR_AT_HW_API;
+        goto errors;
+    }
+    // Wake up event (null data).
+    loop->event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    event.events = EPOLLIN;
+    event.data.ptr = NULL;
+    if ((loop->event_fd < 0) || (epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, loop->event_fd, &event) != 0)) {
+        AT_HW_POSIX_loop_de_init(loop);
+        status = AT_ERROR_AT_HW_API;
+        goto errors;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+AT_status_t AT_HW_POSIX_loop_de_init(AT_HW_POSIX_loop_t *loop) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    // Check parameter.
+    if (loop == NULL) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    while (loop->ports != NULL) {
+        AT_HW_POSIX_loop_remove(loop->ports);
+    }
+    if (loop->event_fd >= 0) {
+        close(loop->event_fd);
+        loop->event_fd = -1;
+    }
+    if (loop->epoll_fd >= 0) {
+        close(loop->epoll_fd);
+        loop->epoll_fd = -1;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+AT_status_t AT_HW_POSIX_loop_add(AT_HW_POSIX_loop_t *loop, AT_HW_POSIX_port_t *port) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    struct epoll_event event;
+    // Check parameters.
+    if ((loop == NULL) || (port == NULL)) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (port->loop != NULL) {
+        status = AT_ERROR_AT_HW_API;
+        goto errors;
+    }
+    event.events = EPOLLIN;
+    event.data.ptr = port;
+    if (epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, port->fd, &event) != 0) {
+        status = AT_ERROR_AT_HW_API;
+        goto errors;
+    }
+    port->events = EPOLLIN;
+    port->loop = loop;
+    port->next = loop->ports;
+    loop->ports = port;
+    // Bytes may already be waiting.
+    _activate(port);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+AT_status_t AT_HW_POSIX_loop_remove(AT_HW_POSIX_port_t *port) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    AT_HW_POSIX_loop_t *loop = NULL;
+    // Check parameter.
+    if (port == NULL) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    loop = port->loop;
+    if (loop == NULL) {
+        goto errors;
+    }
+    // The file descriptor may already be closed.
+    epoll_ctl(loop->epoll_fd, EPOLL_CTL_DEL, port->fd, NULL);
+    _unlink(&(loop->ports), port, 0);
+    if (port->active_flag != 0) {
+        _unlink(&(loop->active), port, 1);
+        _unlink(&(loop->busy), port, 1);
+    }
+    port->loop = NULL;
+    port->next = NULL;
+    port->active_next = NULL;
+    port->active_flag = 0;
+    port->events = 0;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+AT_status_t AT_HW_POSIX_loop_run(AT_HW_POSIX_loop_t *loop, int32_t timeout_ms) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    struct epoll_event events[AT_HW_POSIX_EVENTS_NUMBER];
+    AT_HW_POSIX_port_t *port = NULL;
+    uint64_t counter = 0;
+    int count = 0;
+    int idx = 0;
+    // Check parameter.
+    if (loop == NULL) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Do not wait while ports have work to do.
+    while (loop->busy != NULL) {
+        port = loop->busy;
+        loop->busy = port->active_next;
+        port->active_next = loop->active;
+        loop->active = port;
+    }
+    count = epoll_wait(loop->epoll_fd, events, AT_HW_POSIX_EVENTS_NUMBER, (loop->active != NULL) ? 0 : (int) timeout_ms);
+    if (count < 0) {
+        if (errno != EINTR) {
+            status = AT_ERROR_AT_HW_API;
+            goto errors;
+        }
+        count = 0;
+    }
+    // Timeout: parser timeouts are checked on all the ports.
+    if ((count == 0) && (loop->active == NULL)) {
+        _activate_all(loop);
+    }
+    for (idx = 0; idx < count; idx++) {
+        port = (AT_HW_POSIX_port_t *) events[idx].data.ptr;
+        if (port == NULL) {
+            if (read(loop->event_fd, &counter, sizeof(counter)) < 0) {
+                counter = 0;
+            }
+            _activate_all(loop);
+            continue;
+        }
+        if ((events[idx].events & EPOLLIN) != 0) {
+            _read(port);
+        } else if ((events[idx].events & (EPOLLERR | EPOLLHUP)) != 0) {
+            port->closed_flag = 1;
+        }
+        if ((events[idx].events & EPOLLOUT) != 0) {
+            _flush(port);
+        }
+        _activate(port);
+    }
+    // Process the active ports, the ports with remaining work are processed by the next call.
+    while (loop->active != NULL) {
+        port = loop->active;
+        loop->active = port->active_next;
+        port->active_next = NULL;
+        port->active_flag = 0;
+        if ((port->closed_flag == 0) && (_process(port) != 0) && (port->closed_flag == 0)) {
+            port->active_flag = 1;
+            port->active_next = loop->busy;
+            loop->busy = port;
+        }
+        if (port->closed_flag != 0) {
+            AT_HW_POSIX_loop_remove(port);
+            if (port->close_callback != NULL) {
+                port->close_callback(port);
+            }
+        }
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+AT_status_t AT_HW_POSIX_loop_wakeup(AT_HW_POSIX_loop_t *loop) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    uint64_t counter = 1;
+    // Check parameter.
+    if (loop == NULL) {
+        status = AT_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (write(loop->event_fd, &counter, sizeof(counter)) < 0) {
+        // The counter is already set (EAGAIN).
+        if (errno != EAGAIN) {
+            status = AT_ERROR_AT_HW_API;
+            goto errors;
+        }
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+int AT_HW_POSIX_loop_get_fd(AT_HW_POSIX_loop_t *loop) {
+    return (loop == NULL) ? -1 : loop->epoll_fd;
+}
+
+/*******************************************************************/
+uint8_t AT_HW_POSIX_loop_is_busy(AT_HW_POSIX_loop_t *loop) {
+    return ((loop != NULL) && (loop->busy != NULL)) ? 1 : 0;
+}
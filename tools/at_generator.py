@@ -0,0 +1,535 @@
+#!/usr/bin/env python3
+################################################################################
+#
+# Copyright (c) 2024, UnaBiz SAS
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+#  1 Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+#  2 Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#  3 Neither the name of UnaBiz SAS nor the names of its contributors may be
+#    used to endorse or promote products derived from this software without
+#    specific prior written permission.
+#
+# NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+# THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+# CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+# PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+# BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+# IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+################################################################################
+
+"""AT commands table generator.
+
+Usage: at_generator.py [--compress-help] <spec.json> [<spec.json>...] <output directory>
+
+The JSON spec gives a table name and a list of commands:
+
+    {
+        "name": "sigfox",
+        "commands": [
+            {
+                "syntax": "SF",
+                "type": "extended",
+                "help": "Send a frame",
+                "execution": {"callback": "sf_send_empty", "help": "Send an empty frame"},
+                "read": {"callback": "sf_read_last", "help": "Read the last frame"},
+                "write": {
+                    "callback": "sf_send",
+                    "help": "Send a frame",
+                    "arguments": [{"name": "payload", "type": "hex12"}, {"name": "ack", "type": "u8"}]
+                },
+                "enum_to_str": "sf_error_to_str",
+                "mode": "worker",
+                "resource": 1,
+                "cache_ttl": 0,
+                "id": "SF"
+            }
+        ]
+    }
+
+type is basic, extended (default) or debug, and mode is inline (default), worker or reentrant.
+Write arguments given as a list use the argument schema types of at.h (u8, u16, u32, i8, i16, i32, hex, hexN, str, strN):
+the generated adapter calls callback(const <callback>_arguments_t *arguments, int32_t *error_code) with the converted values.
+Write arguments given as a string (for example "<a>,<b>") keep the raw AT_command_write_cb_t callback.
+
+The generator writes <name>_commands.h and <name>_commands.c:
+    - one constant AT_command_t per command (<NAME>_COMMAND_<id>, id defaults to the syntax),
+    - the <NAME>_COMMANDS table sorted by type then syntax, as expected by AT_register_table(),
+    - <NAME>_register_commands() and <NAME>_register_commands_ex() functions,
+    - the prototypes of the callbacks to implement.
+The help texts are given with the AT_HELP() macro, so that they are removed by the AT_NO_HELP option.
+
+With --compress-help (AT_HELP_COMPRESSED option), the words which save the most bytes over all the specs are moved
+to the AT_HELP_DICTIONARY table of at_help_dictionary.c (at most 128 words, a pointer of 4 bytes is counted for each one),
+and replaced by a single byte (AT_HELP_TOKEN + word index) in the help texts. The help texts must then be ASCII.
+"""
+
+import json
+import os
+import re
+import sys
+
+HELP_TOKEN = 0x80
+HELP_DICTIONARY_SIZE_MAX = 128
+HELP_POINTER_SIZE = 4
+HELP_WORD = re.compile(r"<?\w+>? ?")
+
+IDENTIFIER = re.compile(r"^[A-Za-z_][A-Za-z0-9_]*$")
+COMMAND_IDENTIFIER = re.compile(r"^[A-Za-z0-9_]+$")
+ARGUMENT_TYPE = re.compile(r"^(u8|u16|u32|i8|i16|i32|hex[0-9]*|str[0-9]*)$")
+
+COMMAND_TYPES = {"basic": "AT_COMMAND_TYPE_BASIC", "extended": "AT_COMMAND_TYPE_EXTENDED", "debug": "AT_COMMAND_TYPE_DEBUG"}
+COMMAND_TYPE_ORDER = ["basic", "extended", "debug"]
+COMMAND_MODES = {"inline": "AT_COMMAND_MODE_INLINE", "worker": "AT_COMMAND_MODE_WORKER", "reentrant": "AT_COMMAND_MODE_REENTRANT"}
+COMMAND_HEADERS = {"basic": "", "extended": "$", "debug": "!"}
+
+INTEGER_TYPES = {
+    "u8": ("uint8_t", "u32"),
+    "u16": ("uint16_t", "u32"),
+    "u32": ("uint32_t", "u32"),
+    "i8": ("int8_t", "i32"),
+    "i16": ("int16_t", "i32"),
+    "i32": ("int32_t", "i32"),
+}
+
+
+class SpecError(Exception):
+    pass
+
+
+def _c_string(text):
+    # Escape a string (or compressed help bytes) for a C literal.
+    if text is None:
+        return "NULL"
+    if isinstance(text, str):
+        text = text.encode("utf-8")
+    result = ""
+    for byte in text:
+        if chr(byte) in "\\\"":
+            result += "\\" + chr(byte)
+        elif (byte < 0x20) or (byte > 0x7E):
+            # Close the literal so that the next character is not part of the escape sequence.
+            result += "\\x%02X\"\"" % byte
+        else:
+            result += chr(byte)
+    if result.endswith("\"\""):
+        result = result[:-2]
+    return "\"" + result + "\""
+
+
+def _check_identifier(value, where):
+    if (not isinstance(value, str)) or (IDENTIFIER.match(value) is None):
+        raise SpecError("%s: invalid C identifier %r" % (where, value))
+    return value
+
+
+def _get_action(command, key, where):
+    # Execution, read or write action.
+    action = command.get(key)
+    if action is None:
+        return None
+    if not isinstance(action, dict):
+        raise SpecError("%s.%s: object expected" % (where, key))
+    _check_identifier(action.get("callback"), "%s.%s.callback" % (where, key))
+    return action
+
+
+def _parse_command(command, where):
+    if not isinstance(command, dict):
+        raise SpecError("%s: object expected" % where)
+    syntax = command.get("syntax")
+    if (not isinstance(syntax, str)) or (syntax == "") or any((ord(character) <= 0x20) or (ord(character) > 0x7E) or (character in "=?;,\"") for character in syntax):
+        raise SpecError("%s.syntax: invalid syntax %r" % (where, syntax))
+    command_type = command.get("type", "extended")
+    if command_type not in COMMAND_TYPES:
+        raise SpecError("%s.type: unknown type %r" % (where, command_type))
+    mode = command.get("mode", "inline")
+    if mode not in COMMAND_MODES:
+        raise SpecError("%s.mode: unknown mode %r" % (where, mode))
+    resource = command.get("resource", 0)
+    if (not isinstance(resource, int)) or (resource < 0) or (resource > 31):
+        raise SpecError("%s.resource: number between 0 and 31 expected" % where)
+    cache_ttl = command.get("cache_ttl", 0)
+    if (not isinstance(cache_ttl, int)) or (cache_ttl < 0) or (cache_ttl > 0xFFFFFFFF):
+        raise SpecError("%s.cache_ttl: unsigned 32 bits number expected" % where)
+    # Suffix of the <NAME>_COMMAND_<id> symbol.
+    identifier = command.get("id", re.sub(r"[^A-Za-z0-9_]", "_", syntax).upper())
+    if (not isinstance(identifier, str)) or (COMMAND_IDENTIFIER.match(identifier) is None):
+        raise SpecError("%s.id: invalid identifier %r" % (where, identifier))
+    parsed = {
+        "syntax": syntax,
+        "type": command_type,
+        "help": command.get("help", ""),
+        "mode": mode,
+        "resource": resource,
+        "cache_ttl": cache_ttl,
+        "id": identifier,
+        "enum_to_str": None,
+        "execution": _get_action(command, "execution", where),
+        "read": _get_action(command, "read", where),
+        "write": _get_action(command, "write", where),
+    }
+    if command.get("enum_to_str") is not None:
+        parsed["enum_to_str"] = _check_identifier(command["enum_to_str"], where + ".enum_to_str")
+    if (parsed["execution"] is None) and (parsed["read"] is None) and (parsed["write"] is None):
+        raise SpecError("%s: at least one of execution, read or write is expected" % where)
+    write = parsed["write"]
+    if write is not None:
+        arguments = write.get("arguments")
+        if isinstance(arguments, str):
+            if arguments == "":
+                raise SpecError("%s.write.arguments: empty arguments" % where)
+        elif isinstance(arguments, list) and (len(arguments) > 0):
+            names = set()
+            for position, argument in enumerate(arguments):
+                argument_where = "%s.write.arguments[%u]" % (where, position)
+                if not isinstance(argument, dict):
+                    raise SpecError("%s: object expected" % argument_where)
+                name = _check_identifier(argument.get("name"), argument_where + ".name")
+                if name in names:
+                    raise SpecError("%s.name: duplicated argument %r" % (argument_where, name))
+                names.add(name)
+                if (not isinstance(argument.get("type"), str)) or (ARGUMENT_TYPE.match(argument["type"]) is None):
+                    raise SpecError("%s.type: unknown argument type %r" % (argument_where, argument.get("type")))
+        else:
+            raise SpecError("%s.write.arguments: arguments list or string expected" % where)
+    return parsed
+
+
+def parse_spec(spec):
+    if not isinstance(spec, dict):
+        raise SpecError("spec: object expected")
+    name = _check_identifier(spec.get("name"), "name")
+    commands = spec.get("commands")
+    if (not isinstance(commands, list)) or (len(commands) == 0):
+        raise SpecError("commands: non empty list expected")
+    parsed = [_parse_command(command, "commands[%u]" % idx) for idx, command in enumerate(commands)]
+    # Check duplicates.
+    keys = set()
+    identifiers = set()
+    for command in parsed:
+        key = (command["type"], command["syntax"])
+        if key in keys:
+            raise SpecError("command %s%s: duplicated syntax" % (COMMAND_HEADERS[command["type"]], command["syntax"]))
+        keys.add(key)
+        if command["id"] in identifiers:
+            raise SpecError("command %s%s: duplicated id %r (use the id field)" % (COMMAND_HEADERS[command["type"]], command["syntax"], command["id"]))
+        identifiers.add(command["id"])
+    # Sort by type then syntax (strcmp order), as checked by AT_register_table().
+    parsed.sort(key=lambda command: (COMMAND_TYPE_ORDER.index(command["type"]), command["syntax"].encode("ascii")))
+    return name, parsed
+
+
+def _get_help_texts(command):
+    # Texts printed by the help (AT? and AT<command>=?).
+    texts = [command["help"]]
+    for key in ("execution", "read", "write"):
+        if command[key] is not None:
+            texts.append(command[key].get("help", ""))
+    if command["write"] is not None:
+        texts.append(_get_write_arguments(command))
+    return texts
+
+
+def build_help_dictionary(tables):
+    # Words of all the help texts, selected by saved bytes.
+    counts = {}
+    for name, commands in tables:
+        for command in commands:
+            for text in _get_help_texts(command):
+                if (not isinstance(text, str)) or any(ord(character) >= HELP_TOKEN for character in text):
+                    raise SpecError("%s: command %s%s: ASCII help texts expected to compress them" % (name, COMMAND_HEADERS[command["type"]], command["syntax"]))
+                for word in HELP_WORD.findall(text):
+                    counts[word] = counts.get(word, 0) + 1
+    savings = []
+    for word, count in counts.items():
+        saved = (count * (len(word) - 1)) - (len(word) + 1 + HELP_POINTER_SIZE)
+        if saved > 0:
+            savings.append((-saved, word))
+    savings.sort()
+    words = [word for _, word in savings[:HELP_DICTIONARY_SIZE_MAX]]
+    return {word: idx for idx, word in enumerate(words)}
+
+
+def _compress_help(text, dictionary):
+    result = b""
+    position = 0
+    for match in HELP_WORD.finditer(text):
+        if match.group(0) in dictionary:
+            result += text[position:match.start()].encode("ascii") + bytes([HELP_TOKEN + dictionary[match.group(0)]])
+            position = match.end()
+    return result + text[position:].encode("ascii")
+
+
+def _help_string(text, dictionary):
+    # Removed by the AT_NO_HELP option.
+    if dictionary is not None:
+        text = _compress_help(text, dictionary)
+    return "AT_HELP(%s)" % _c_string(text)
+
+
+def _is_typed(command):
+    return (command["write"] is not None) and isinstance(command["write"]["arguments"], list)
+
+
+def _get_schema(command):
+    return ",".join(argument["type"] for argument in command["write"]["arguments"])
+
+
+def _get_write_arguments(command):
+    arguments = command["write"]["arguments"]
+    if isinstance(arguments, str):
+        return arguments
+    return ",".join("<%s>" % argument["name"] for argument in arguments)
+
+
+def _get_arguments_fields(command):
+    fields = []
+    for argument in command["write"]["arguments"]:
+        argument_type = argument["type"]
+        if argument_type in INTEGER_TYPES:
+            fields.append("    %s %s;" % (INTEGER_TYPES[argument_type][0], argument["name"]))
+        elif argument_type.startswith("hex"):
+            fields.append("    uint8_t *%s;" % argument["name"])
+            fields.append("    uint32_t %s_size;" % argument["name"])
+        else:
+            fields.append("    char *%s;" % argument["name"])
+            fields.append("    uint32_t %s_size;" % argument["name"])
+    return fields
+
+
+def _get_arguments_copy(command):
+    lines = []
+    for position, argument in enumerate(command["write"]["arguments"]):
+        argument_type = argument["type"]
+        name = argument["name"]
+        if argument_type in INTEGER_TYPES:
+            c_type, member = INTEGER_TYPES[argument_type]
+            lines.append("    arguments.%s = (%s) argv[%u].value.%s;" % (name, c_type, position, member))
+        elif argument_type.startswith("hex"):
+            lines.append("    arguments.%s = argv[%u].value.hex.data;" % (name, position))
+            lines.append("    arguments.%s_size = argv[%u].value.hex.size;" % (name, position))
+        else:
+            lines.append("    arguments.%s = argv[%u].value.str.data;" % (name, position))
+            lines.append("    arguments.%s_size = argv[%u].value.str.size;" % (name, position))
+    return lines
+
+
+def _file_header(file_name, brief, spec_name):
+    return [
+        "/*!*****************************************************************",
+        " * \\file    %s" % file_name,
+        " * \\brief   %s" % brief,
+        " *******************************************************************",
+        " * Generated by at_generator.py from %s, do not edit." % spec_name,
+        " *******************************************************************/",
+        "",
+    ]
+
+
+def generate_header(name, commands, spec_name):
+    prefix = name.upper()
+    guard = "__%s_COMMANDS_H__" % prefix
+    lines = _file_header("%s_commands.h" % name, "%s AT commands table." % name, spec_name)
+    lines += ["#ifndef %s" % guard, "#define %s" % guard, "", "#include \"at.h\"", ""]
+    lines += ["/*** %s_COMMANDS macros ***/" % prefix, "", "#define %s_COMMANDS_SIZE    %u" % (prefix, len(commands)), ""]
+    typed = [command for command in commands if _is_typed(command)]
+    if typed:
+        lines += ["/*** %s_COMMANDS structures ***/" % prefix, ""]
+        for command in typed:
+            callback = command["write"]["callback"]
+            lines += [
+                "/*!******************************************************************",
+                " * \\struct %s_arguments_t" % callback,
+                " * \\brief Converted write arguments of the %s%s command (%s)." % (COMMAND_HEADERS[command["type"]], command["syntax"], _get_schema(command)),
+                " *******************************************************************/",
+                "typedef struct {",
+            ]
+            lines += _get_arguments_fields(command)
+            lines += ["} %s_arguments_t;" % callback, ""]
+    lines += ["/*** %s_COMMANDS global variables ***/" % prefix, ""]
+    for command in commands:
+        lines.append("extern const AT_command_t %s_COMMAND_%s;" % (prefix, command["id"]))
+    lines += ["extern const AT_command_t *const %s_COMMANDS[%s_COMMANDS_SIZE];" % (prefix, prefix), ""]
+    lines += ["/*** %s_COMMANDS callbacks (to be implemented by the application) ***/" % prefix, ""]
+    for command in commands:
+        if command["execution"] is not None:
+            lines.append("AT_status_t %s(int32_t *error_code);" % command["execution"]["callback"])
+        if command["read"] is not None:
+            lines.append("AT_status_t %s(int32_t *error_code);" % command["read"]["callback"])
+        if command["write"] is not None:
+            if _is_typed(command):
+                lines.append("AT_status_t %s(const %s_arguments_t *arguments, int32_t *error_code);" % (command["write"]["callback"], command["write"]["callback"]))
+            else:
+                lines.append("AT_status_t %s(uint32_t argc, char *argv[], int32_t *error_code);" % command["write"]["callback"])
+        if command["enum_to_str"] is not None:
+            lines.append("const char *%s(unsigned int error_code);" % command["enum_to_str"])
+    lines += ["", "/*** %s_COMMANDS functions ***/" % prefix, ""]
+    lines += [
+        "/*!******************************************************************",
+        " * \\fn AT_status_t %s_register_commands(void)" % prefix,
+        " * \\brief Register the %s commands table on the default instance." % name,
+        " * \\param[in]   none",
+        " * \\param[out]  none",
+        " * \\retval      Function execution status.",
+        " *******************************************************************/",
+        "AT_status_t %s_register_commands(void);" % prefix,
+        "",
+        "/*!******************************************************************",
+        " * \\fn AT_status_t %s_register_commands_ex(AT_handle_t *handle)" % prefix,
+        " * \\brief Register the %s commands table on an instance." % name,
+        " * \\param[in]   handle: Pointer to the instance.",
+        " * \\param[out]  none",
+        " * \\retval      Function execution status.",
+        " *******************************************************************/",
+        "AT_status_t %s_register_commands_ex(AT_handle_t *handle);" % prefix,
+        "",
+        "#endif /* %s */" % guard,
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def generate_source(name, commands, spec_name, dictionary=None):
+    prefix = name.upper()
+    lines = _file_header("%s_commands.c" % name, "%s AT commands table." % name, spec_name)
+    lines += ["#include \"%s_commands.h\"" % name, "", "#include \"at.h\"", "#include \"stddef.h\"", ""]
+    typed = [command for command in commands if _is_typed(command)]
+    if typed:
+        lines += ["/*** %s_COMMANDS local functions ***/" % prefix, ""]
+        for command in typed:
+            callback = command["write"]["callback"]
+            lines += [
+                "/*******************************************************************/",
+                "static AT_status_t _%s_typed_write(uint32_t argc, AT_argument_t *argv, int32_t *error_code) {" % callback,
+                "    // Local variables.",
+                "    %s_arguments_t arguments;" % callback,
+                "    // Arguments number and values are checked by the parser with the schema.",
+                "    (void) argc;",
+            ]
+            lines += _get_arguments_copy(command)
+            lines += ["    return %s(&arguments, error_code);" % callback, "}", ""]
+    lines += ["/*** %s_COMMANDS global variables ***/" % prefix, ""]
+    for command in commands:
+        execution = command["execution"]
+        read = command["read"]
+        write = command["write"]
+        typed_flag = _is_typed(command)
+        lines += [
+            "const AT_command_t %s_COMMAND_%s = {" % (prefix, command["id"]),
+            "    .syntax = %s," % _c_string(command["syntax"]),
+            "    .type = %s," % COMMAND_TYPES[command["type"]],
+            "    .help = %s," % _help_string(command["help"], dictionary),
+            "    .execution_callback = %s," % (("&" + execution["callback"]) if execution is not None else "NULL"),
+            "    .execution_help = %s," % (_help_string(execution.get("help", ""), dictionary) if execution is not None else "NULL"),
+            "    .read_callback = %s," % (("&" + read["callback"]) if read is not None else "NULL"),
+            "    .read_help = %s," % (_help_string(read.get("help", ""), dictionary) if read is not None else "NULL"),
+            "    .write_callback = %s," % (("&" + write["callback"]) if ((write is not None) and (not typed_flag)) else "NULL"),
+            "    .write_arguments = %s," % (_help_string(_get_write_arguments(command), dictionary) if write is not None else "NULL"),
+            "    .write_help = %s," % (_help_string(write.get("help", ""), dictionary) if write is not None else "NULL"),
+            "    .enum_to_str_callback = %s," % (("&" + command["enum_to_str"]) if command["enum_to_str"] is not None else "NULL"),
+            "    .write_schema = %s," % (_c_string(_get_schema(command)) if typed_flag else "NULL"),
+            "    .typed_write_callback = %s," % (("&_%s_typed_write" % write["callback"]) if typed_flag else "NULL"),
+            "    .mode = %s," % COMMAND_MODES[command["mode"]],
+            "    .resource = %u," % command["resource"],
+            "    .cache_ttl = %u," % command["cache_ttl"],
+            "};",
+            "",
+        ]
+    lines += ["// Sorted by type then by syntax.", "const AT_command_t *const %s_COMMANDS[%s_COMMANDS_SIZE] = {" % (prefix, prefix)]
+    for command in commands:
+        lines.append("    &%s_COMMAND_%s," % (prefix, command["id"]))
+    lines += ["};", ""]
+    lines += [
+        "/*** %s_COMMANDS functions ***/" % prefix,
+        "",
+        "/*******************************************************************/",
+        "AT_status_t %s_register_commands(void) {" % prefix,
+        "    return AT_register_table(%s_COMMANDS, %s_COMMANDS_SIZE);" % (prefix, prefix),
+        "}",
+        "",
+        "/*******************************************************************/",
+        "AT_status_t %s_register_commands_ex(AT_handle_t *handle) {" % prefix,
+        "    return AT_register_table_ex(handle, %s_COMMANDS, %s_COMMANDS_SIZE);" % (prefix, prefix),
+        "}",
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def generate_dictionary(dictionary, spec_names):
+    lines = _file_header("at_help_dictionary.c", "AT compressed help dictionary.", ", ".join(spec_names))
+    lines += ["#include \"at.h\"", "", "/*** AT global variables ***/", "", "// Indexed by (help byte - AT_HELP_TOKEN)."]
+    lines.append("const char *const AT_HELP_DICTIONARY[%u] = {" % max(len(dictionary), 1))
+    for word in sorted(dictionary, key=lambda word: dictionary[word]):
+        lines.append("    %s," % _c_string(word))
+    if len(dictionary) == 0:
+        lines.append("    \"\",")
+    lines += ["};", "", "const uint8_t AT_HELP_DICTIONARY_SIZE = %u;" % len(dictionary), ""]
+    return "\n".join(lines)
+
+
+def _write_if_changed(path, content):
+    # Keep the timestamp of unchanged files to avoid useless rebuilds.
+    if os.path.exists(path):
+        with open(path, "r", encoding="ascii") as existing:
+            if existing.read() == content:
+                return
+    with open(path, "w", encoding="ascii", newline="\n") as output:
+        output.write(content)
+
+
+def main(argv):
+    arguments = argv[1:]
+    compress_help = (len(arguments) > 0) and (arguments[0] == "--compress-help")
+    if compress_help:
+        arguments = arguments[1:]
+    if len(arguments) < 2:
+        sys.stderr.write("usage: %s [--compress-help] <spec.json> [<spec.json>...] <output directory>\n" % argv[0])
+        return 1
+    spec_paths = arguments[:-1]
+    output_directory = arguments[-1]
+    tables = []
+    for spec_path in spec_paths:
+        try:
+            with open(spec_path, "r", encoding="utf-8") as spec_file:
+                spec = json.load(spec_file)
+            name, commands = parse_spec(spec)
+            if name in [table[0] for table in tables]:
+                raise SpecError("name: duplicated table name %r" % name)
+        except (OSError, ValueError, SpecError) as error:
+            sys.stderr.write("%s: %s\n" % (spec_path, error))
+            return 1
+        tables.append((name, commands))
+    spec_names = [os.path.basename(spec_path) for spec_path in spec_paths]
+    dictionary = None
+    if compress_help:
+        try:
+            dictionary = build_help_dictionary(tables)
+        except SpecError as error:
+            sys.stderr.write("%s\n" % error)
+            return 1
+    os.makedirs(output_directory, exist_ok=True)
+    for (name, commands), spec_name in zip(tables, spec_names):
+        _write_if_changed(os.path.join(output_directory, "%s_commands.h" % name), generate_header(name, commands, spec_name))
+        _write_if_changed(os.path.join(output_directory, "%s_commands.c" % name), generate_source(name, commands, spec_name, dictionary))
+    if compress_help:
+        _write_if_changed(os.path.join(output_directory, "at_help_dictionary.c"), generate_dictionary(dictionary, spec_names))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))